@@ -0,0 +1,51 @@
+#include "allocation_counter.hpp"
+
+#include "nuclear-data-reader/load_stats.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/core.h>
+#include <fmt/os.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+
+
+TEST_CASE("Allocations made in each phase", "[MassTable][allocations]")
+{
+  // 1997 is read from the same files as 1995 so is not listed
+  constexpr std::array<uint16_t, 7> years{ 1983, 1993, 1995, 2003, 2012, 2016, 2020 };
+
+  fmt::print("New json formatted file: {}\n", NDR_ALLOCATION_OUTPUT);
+  auto out = fmt::output_file(NDR_ALLOCATION_OUTPUT);
+
+  out.print("[\n");
+  for (auto year = years.cbegin(); year != years.cend(); ++year)
+    {
+      MassTable table(*year);
+      table.allocation_probe = AllocationCounter::current;
+
+      REQUIRE(table.populateInternalMassTable());
+      REQUIRE(table.outputTableToJSON());
+      REQUIRE(table.outputTableToCSV());
+
+      std::string phases;
+      for (std::size_t phase = 0; phase < table.load_stats.phases.size(); ++phase)
+        {
+          const auto& stats = table.load_stats.phases[phase];
+          phases += fmt::format(R"({}{{"phase":"{}","wall_time_ns":{},"allocations":{},"allocated_bytes":{}}})",
+                                phase == 0 ? "" : ",",
+                                LoadStats::phase_names[phase],
+                                stats.wall_time.count(),
+                                stats.allocations,
+                                stats.allocated_bytes);
+        }
+
+      out.print(R"({{"year":{},"phases":[{}]}}{})", *year, phases, (year != std::prev(years.cend())) ? ",\n" : "\n");
+    }
+  out.print("]\n");
+}
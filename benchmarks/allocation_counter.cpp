@@ -0,0 +1,92 @@
+#include "allocation_counter.hpp"
+
+#include "nuclear-data-reader/load_stats.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+
+namespace
+{
+  std::atomic<uint64_t> allocations{ 0 };
+  std::atomic<uint64_t> bytes{ 0 };
+
+  /**
+   * Record an allocation and make it
+   *
+   * \param The number of bytes requested
+   * \param The alignment of the allocation, 0 to use the default
+   *
+   * \return The memory, or nullptr if it could not be allocated
+   */
+  void* countedAllocation(std::size_t size, const std::size_t alignment) noexcept
+  {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+
+    // malloc(0) is allowed to return nullptr, new is not
+    size = (size == 0) ? 1 : size;
+
+    if (alignment == 0)
+      {
+        return std::malloc(size);
+      }
+
+    // aligned_alloc requires the size to be a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+  }
+} // namespace
+
+
+AllocationCount AllocationCounter::current() noexcept
+{
+  return { allocations.load(std::memory_order_relaxed), bytes.load(std::memory_order_relaxed) };
+}
+
+
+// The array and nothrow versions all call one of these by default so don't need replacing
+void* operator new(std::size_t size)
+{
+  if (auto* memory = countedAllocation(size, 0); memory != nullptr)
+    {
+      return memory;
+    }
+  throw std::bad_alloc();
+}
+
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  if (auto* memory = countedAllocation(size, static_cast<std::size_t>(alignment)); memory != nullptr)
+    {
+      return memory;
+    }
+  throw std::bad_alloc();
+}
+
+
+void operator delete(void* memory) noexcept
+{
+  std::free(memory);
+}
+
+
+void operator delete(void* memory, std::align_val_t /*alignment*/) noexcept
+{
+  std::free(memory);
+}
+
+
+void operator delete(void* memory, std::size_t /*size*/) noexcept
+{
+  std::free(memory);
+}
+
+
+void operator delete(void* memory, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+  std::free(memory);
+}
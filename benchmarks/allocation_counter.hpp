@@ -0,0 +1,27 @@
+/**
+ *
+ * \brief Count every allocation made by the program
+ *
+ * Linking allocation_counter.cpp into an executable replaces the global operator new and delete with versions that
+ * keep a running total of the allocations made, in any library. Only used by the benchmarks, where it is switched on
+ * with NDR_BENCHMARK_ALLOCATIONS, as the counting slows everything down slightly.
+ */
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include "nuclear-data-reader/load_stats.hpp"
+
+
+namespace AllocationCounter
+{
+  /**
+   * Get the totals, since the program started, suitable for use as MassTable::allocation_probe
+   *
+   * \param Nothing
+   *
+   * \return The number of allocations and the bytes requested
+   */
+  [[nodiscard]] AllocationCount current() noexcept;
+} // namespace AllocationCounter
+
+#endif // ALLOCATION_COUNTER_HPP
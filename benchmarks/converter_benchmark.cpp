@@ -0,0 +1,46 @@
+#include "nuclear-data-reader/converter.hpp"
+
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+
+TEST_CASE("Convert strings to numbers", "[Converter]")
+{
+  constexpr std::string_view line{ "  987.654  123 " };
+
+  BENCHMARK("StringToNum<double>")
+  {
+    return Converter::StringToNum<double>(line, 2, 9);
+  };
+
+  BENCHMARK("StringToNum<uint8_t>")
+  {
+    return Converter::StringToNum<uint8_t>(line, 11, 14);
+  };
+}
+
+
+TEST_CASE("Convert numbers to strings", "[Converter]")
+{
+  BENCHMARK("FloatToNdp")
+  {
+    return Converter::FloatToNdp(-52435.3874, 4);
+  };
+}
+
+
+TEST_CASE("Convert half-lives to durations", "[Converter]")
+{
+  BENCHMARK("ToDuration with a string unit")
+  {
+    return Converter::ToDuration(294.4, "ns");
+  };
+
+  BENCHMARK("ToDuration with a TimeUnit")
+  {
+    return Converter::ToDuration(294.4, Converter::TimeUnit::NANOSECONDS);
+  };
+}
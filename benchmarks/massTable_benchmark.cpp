@@ -0,0 +1,185 @@
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/nuclide_key.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+  /// 1997 is read from the same files as 1995 so is not listed
+  constexpr std::array<uint16_t, 7> years{ 1983, 1993, 1995, 2003, 2012, 2016, 2020 };
+
+  /**
+   * Create a table that is ready to have its files read, and that does not print anything
+   *
+   * \param The year of the table
+   *
+   * \return The table
+   */
+  MassTable emptyTable(const uint16_t year)
+  {
+    MassTable table(year);
+    table.diagnostics.silence();
+    table.setFilePaths();
+    return table;
+  }
+} // namespace
+
+
+TEST_CASE("Read each data file", "[MassTable]")
+{
+  for (const auto year : years)
+    {
+      const auto empty = emptyTable(year);
+
+      BENCHMARK_ADVANCED(fmt::format("readAMEMassFile {}", year))(Catch::Benchmark::Chronometer meter)
+      {
+        std::vector<MassTable> tables(static_cast<std::size_t>(meter.runs()), empty);
+        meter.measure([&tables](const int i) {
+          const auto& table = tables[static_cast<std::size_t>(i)];
+          return table.readAMEMassFile(table.AME_masstable);
+        });
+      };
+
+      // The reaction files fill in isotopes that are already in the table
+      auto with_masses = emptyTable(year);
+      [[maybe_unused]] const auto masses = with_masses.readAMEMassFile(with_masses.AME_masstable);
+
+      BENCHMARK_ADVANCED(fmt::format("readAMEReactionFileOne {}", year))(Catch::Benchmark::Chronometer meter)
+      {
+        std::vector<MassTable> tables(static_cast<std::size_t>(meter.runs()), with_masses);
+        meter.measure([&tables](const int i) {
+          const auto& table = tables[static_cast<std::size_t>(i)];
+          return table.readAMEReactionFileOne(table.AME_reaction_1);
+        });
+      };
+
+      BENCHMARK_ADVANCED(fmt::format("readAMEReactionFileTwo {}", year))(Catch::Benchmark::Chronometer meter)
+      {
+        std::vector<MassTable> tables(static_cast<std::size_t>(meter.runs()), with_masses);
+        meter.measure([&tables](const int i) {
+          const auto& table = tables[static_cast<std::size_t>(i)];
+          return table.readAMEReactionFileTwo(table.AME_reaction_2);
+        });
+      };
+
+      if (year <= MassTable::LAST_YEAR_AME_ONLY)
+        {
+          continue;
+        }
+
+      BENCHMARK_ADVANCED(fmt::format("readNUBASE {}", year))(Catch::Benchmark::Chronometer meter)
+      {
+        std::vector<MassTable> tables(static_cast<std::size_t>(meter.runs()), empty);
+        meter.measure([&tables](const int i) {
+          auto& table = tables[static_cast<std::size_t>(i)];
+          return table.readNUBASE(table.NUBASE_masstable);
+        });
+      };
+    }
+}
+
+
+TEST_CASE("Merge the AME and NUBASE data", "[MassTable]")
+{
+  for (const auto year : years)
+    {
+      if (year <= MassTable::LAST_YEAR_AME_ONLY)
+        {
+          continue;
+        }
+
+      auto unmerged = emptyTable(year);
+      [[maybe_unused]] const auto ame    = unmerged.readAME();
+      [[maybe_unused]] const auto nubase = unmerged.readNUBASE(unmerged.NUBASE_masstable);
+
+      BENCHMARK_ADVANCED(fmt::format("mergeData {}", year))(Catch::Benchmark::Chronometer meter)
+      {
+        std::vector<MassTable> tables(static_cast<std::size_t>(meter.runs()), unmerged);
+        meter.measure([&tables](const int i) { return tables[static_cast<std::size_t>(i)].mergeData(); });
+      };
+    }
+}
+
+
+TEST_CASE("Populate the full table", "[MassTable]")
+{
+  for (const auto year : years)
+    {
+      BENCHMARK_ADVANCED(fmt::format("populateInternalMassTable {}", year))(Catch::Benchmark::Chronometer meter)
+      {
+        MassTable quiet(year);
+        quiet.diagnostics.silence();
+
+        std::vector<MassTable> tables(static_cast<std::size_t>(meter.runs()), quiet);
+        meter.measure(
+            [&tables](const int i) { return tables[static_cast<std::size_t>(i)].populateInternalMassTable(); });
+      };
+    }
+}
+
+
+TEST_CASE("Export the full table", "[MassTable]")
+{
+  MassTable table(2020);
+  table.diagnostics.silence();
+  REQUIRE(table.populateInternalMassTable());
+
+  BENCHMARK("outputTableToJSON 2020")
+  {
+    return table.outputTableToJSON();
+  };
+
+  BENCHMARK("outputTableToCSV 2020")
+  {
+    return table.outputTableToCSV();
+  };
+}
+
+
+TEST_CASE("Look up many isotopes", "[MassTable]")
+{
+  MassTable table(2020);
+  table.diagnostics.silence();
+  REQUIRE(table.populateInternalMassTable());
+
+  // Every isotope, in an order that jumps around the chart
+  std::vector<NuclideKey> keys;
+  keys.reserve(table.fullDataTable.size());
+  for (const auto& isotope : table.fullDataTable)
+    {
+      keys.emplace_back(isotope.ame.A, isotope.ame.Z);
+    }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937{ 2020 });
+
+  std::vector<const Isotope*> results(keys.size(), nullptr);
+
+  BENCHMARK("lookupMany 2020")
+  {
+    return table.lookupMany(keys, results);
+  };
+
+  BENCHMARK("getQuantity for each key 2020")
+  {
+    std::size_t found{ 0 };
+    for (const auto key : keys)
+      {
+        if (table.getQuantity(key.A(), key.Z(), Quantity::AME_MASS_EXCESS))
+          {
+            ++found;
+          }
+      }
+    return found;
+  };
+}
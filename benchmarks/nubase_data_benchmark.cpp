@@ -0,0 +1,26 @@
+#include "nuclear-data-reader/nubase_data.hpp"
+
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+
+TEST_CASE("Parse a NUBASE line", "[NUBASEData]")
+{
+  const std::string line{ "095 0360   95Kr   -56159         19                                   114     ms 3      "
+                          "1/2+*         10          1994 B-=100;B-n=2.87 18;B-2n ?" };
+  const NUBASE::Data data(line, 2020);
+
+  BENCHMARK("setSpinParity")
+  {
+    data.setSpinParity();
+    return data.J;
+  };
+
+  BENCHMARK("setHalfLife")
+  {
+    data.setHalfLife();
+    return data.hl;
+  };
+}
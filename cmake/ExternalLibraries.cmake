@@ -6,4 +6,8 @@ function(add_external_libraries project_name)
   add_subdirectory(external/fmt EXCLUDE_FROM_ALL)
   # Using fmt::output_file requires the compiled library. We can't use header only
   target_link_libraries(project_options INTERFACE fmt::fmt)
+
+  # TableHandle reloads tables on a separate thread
+  find_package(Threads REQUIRED)
+  target_link_libraries(project_options INTERFACE Threads::Threads)
 endfunction(add_external_libraries)
@@ -13,6 +13,7 @@
 #include "nuclear-data-reader/ame_reaction1_position.hpp"
 #include "nuclear-data-reader/ame_reaction2_position.hpp"
 #include "nuclear-data-reader/converter.hpp"
+#include "nuclear-data-reader/nuclide_key.hpp"
 #include "nuclear-data-reader/number.hpp"
 #include <string_view>
 
@@ -81,8 +82,8 @@ namespace AME
     mutable Number s_p{};
     /// Two proton separation energy
     mutable Number s_2p{};
-    ///
-    mutable Number dV_pn{};
+    /// Interaction of the last protons with the last neutrons, calculated from the masses as they are not in the files
+    mutable Number dV_pn{ Number::MISSING };
     /// Q-alpha value
     mutable Number q_a{};
     /// Q 2 beta minus
@@ -103,6 +104,39 @@ namespace AME
     /// The entire line for the isotope from the data file
     mutable std::string full_data{};
 
+    /**
+     * The key used to index and join the tables
+     *
+     * \param Nothing
+     *
+     * \return The key of the isotope
+     */
+    [[nodiscard]] inline NuclideKey key() const noexcept { return { A, Z }; }
+
+    /**
+     * Copy only the values that come from the reaction files, so the rest of the isotope, including full_data, is
+     * untouched and can be read by other threads while this happens
+     *
+     * \param The isotope to copy the values from
+     *
+     * \return Nothing
+     */
+    inline void setReactionValues(const Data& other) const
+    {
+      s_n    = other.s_n;
+      s_2n   = other.s_2n;
+      s_p    = other.s_p;
+      s_2p   = other.s_2p;
+      q_a    = other.q_a;
+      q_2bm  = other.q_2bm;
+      q_ep   = other.q_ep;
+      q_bm_n = other.q_bm_n;
+      q_4bm  = other.q_4bm;
+      q_da   = other.q_da;
+      q_pa   = other.q_pa;
+      q_na   = other.q_na;
+    }
+
     /**
      * Extract the neutron number
      *
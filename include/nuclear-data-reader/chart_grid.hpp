@@ -0,0 +1,132 @@
+/**
+ *
+ * \class ChartGrid
+ *
+ * \brief A single quantity of a populated table, as a dense raster over (Z, N) ready to be drawn as a chart
+ *
+ * The grid is filled in one pass over the grid of the table's ChartIndex, so no isotope is searched for. Values are
+ * stored by row, value[Z * columns + N], with NaN where there is no value. Whether there is an isotope at each point
+ * is stored separately, so an isotope without a value can still be drawn.
+ *
+ * The grid can be written as a binary file, a 16 byte header followed by every value, every error and then every
+ * flag, or as a text matrix that gnuplot can plot directly with `plot 'file' matrix with image`.
+ */
+#ifndef CHARTGRID_HPP
+#define CHARTGRID_HPP
+
+#include "nuclear-data-reader/diagnostics.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+class ChartGrid
+{
+public:
+  ChartGrid() = default;
+
+  ChartGrid(const ChartGrid&)     = default;
+  ChartGrid(ChartGrid&&) noexcept = default;
+
+  ChartGrid& operator=(const ChartGrid&)     = default;
+  ChartGrid& operator=(ChartGrid&&) noexcept = default;
+
+  ~ChartGrid() = default;
+
+  /// Size of the header at the start of the binary file
+  static constexpr std::size_t BINARY_HEADER_SIZE{ 16 };
+
+  /// Where messages are sent
+  Diagnostics diagnostics{};
+
+  /// The year of the table the grid was filled from, 0 if it hasn't been
+  uint16_t year{ 0 };
+  /// The quantity in the grid
+  Quantity quantity{ Quantity::AME_MASS_EXCESS };
+  /// Number of rows, i.e. the largest Z + 1
+  uint16_t rows{ 0 };
+  /// Number of columns, i.e. the largest N + 1
+  uint16_t columns{ 0 };
+
+  /// The value at each point, NaN if there is no isotope or it has no value
+  std::vector<double> value;
+  /// The uncertainty on each value, NaN if there isn't one
+  std::vector<double> error;
+  /// 1 if there is an isotope at the point, 0 otherwise
+  std::vector<uint8_t> exists;
+
+  /**
+   * Fill the grid from a populated table, discarding anything already in it. Deferred reaction files are read first
+   * if the quantity is in them.
+   *
+   * \param The populated table
+   * \param The quantity to fill the grid with
+   *
+   * \return[TRUE] The grid has been filled
+   * \return[FALSE] The table has not been populated
+   */
+  [[nodiscard]] bool fill(const MassTable& table, const Quantity _quantity);
+
+  /**
+   * Get where a point on the chart is stored in the grid
+   *
+   * \param The proton number
+   * \param The neutron number
+   *
+   * \return The index into value, error and exists, which is only valid if Z < rows and N < columns
+   */
+  [[nodiscard]] inline std::size_t slot(const uint16_t Z, const uint16_t N) const noexcept
+  {
+    return static_cast<std::size_t>(Z) * columns + N;
+  }
+
+  /**
+   * Get the value at a single point
+   *
+   * \param The proton number
+   * \param The neutron number
+   *
+   * \return[PASS] The value and its uncertainty, if it has one
+   * \return[FAIL] An empty optional if the point is outside the grid or has no value
+   */
+  [[nodiscard]] std::optional<Number> at(const uint16_t Z, const uint16_t N) const;
+
+  /**
+   * Create the header of the binary file: "NDRGRD01", the year, the quantity, a zero byte, then rows and columns.
+   * All numbers are in the byte order of the machine writing the file.
+   *
+   * \param Nothing
+   *
+   * \return The header
+   */
+  [[nodiscard]] std::array<char, BINARY_HEADER_SIZE> writeBinaryHeader() const noexcept;
+
+  /**
+   * Write the grid as binary, to masstable_<year>_<quantity>.bin
+   *
+   * \param Nothing
+   *
+   * \return[TRUE] The file has been written
+   * \return[FALSE] The grid has not been filled, or the file could not be written
+   */
+  [[nodiscard]] bool outputGridToBinary() const;
+
+  /**
+   * Write the values as a text matrix, one row per Z, to masstable_<year>_<quantity>.dat. Points without a value are
+   * written as NaN, which gnuplot leaves blank.
+   *
+   * \param Nothing
+   *
+   * \return[TRUE] The file has been written
+   * \return[FALSE] The grid has not been filled
+   */
+  [[nodiscard]] bool outputGridToMatrix() const;
+};
+
+#endif // CHARTGRID_HPP
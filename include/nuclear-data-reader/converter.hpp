@@ -27,6 +27,7 @@
 #include <limits>
 #include <optional>
 #include <ratio>
+#include <span>
 #include <string>
 #include <utility>
 
@@ -63,6 +64,60 @@ public:
   using millionyears = std::chrono::duration<double, std::ratio<1000000 * year, 1>>;
   using billionyears = std::chrono::duration<double, std::ratio<1000000000 * year, 1>>;
 
+  /// The units a half life can be given in, UNKNOWN must stay as the last entry
+  enum class TimeUnit : uint8_t
+  {
+    YOCTOSECONDS,
+    ZEPTOSECONDS,
+    ATTOSECONDS,
+    PICOSECONDS,
+    NANOSECONDS,
+    MICROSECONDS,
+    MILLISECONDS,
+    SECONDS,
+    MINUTES,
+    HOURS,
+    DAYS,
+    YEARS,
+    KILOYEARS,
+    MILLIONYEARS,
+    BILLIONYEARS,
+    TERAYEARS,
+    PETAYEARS,
+    EXAYEARS,
+    ZETTAYEARS,
+    YOTTAYEARS,
+    UNKNOWN
+  };
+
+  /**
+   * \struct TimeScale
+   *
+   * \brief How to get from a value in a given unit to seconds
+   *
+   * The value is converted as (pre * value) * num / den, which are the same floating point operations, in the same
+   * order, that std::chrono performs when casting the matching duration type to seconds
+   */
+  struct TimeScale
+  {
+    double pre{ 1.0 };
+    double num{ 1.0 };
+    double den{ 1.0 };
+  };
+
+  /// Get the TimeScale of a std::chrono::duration, with an optional multiplier to handle the units we have no type for
+  template<typename Duration>
+  [[nodiscard]] static constexpr TimeScale make_scale(const double pre = 1.0) noexcept
+  {
+    return { pre, static_cast<double>(Duration::period::num), static_cast<double>(Duration::period::den) };
+  }
+
+  /// Scale factor of every TimeUnit, indexed by the enum value, defined, at compile time, after the class
+  static const std::array<TimeScale, static_cast<std::size_t>(TimeUnit::UNKNOWN) + 1> timeScale;
+
+  /// What we use for a half life with a unit we do not recognise, effectively stable
+  static constexpr double unknown_unit_seconds{ 1.0e24 };
+
   // Lambda function to cast as required and avoid copy paste errors if we ever need larger values
   static constexpr auto DRY_cast = [](const int value) mutable { return static_cast<uint16_t>(value); };
 
@@ -102,6 +157,41 @@ public:
       { "Lv", DRY_cast(116) }, { "Ts", DRY_cast(117) }, { "Og", DRY_cast(118) } }
   };
 
+  /// Elemental symbols are 1 or 2 characters, ^[A-Z][a-z]?$, so there are 26 * 27 possible values.
+  /// Every one gets a slot, which makes the hash of a symbol unique without needing to search.
+  static constexpr std::size_t SYMBOL_HASH_SIZE{ 26 * 27 };
+  /// Marks a slot in the hash table that doesn't correspond to an element
+  static constexpr uint8_t NO_ELEMENT{ std::numeric_limits<uint8_t>::max() };
+
+  /**
+   * Perfect hash of an elemental symbol, the neutron, "n", is not included and needs to be handled separately.
+   *
+   * \param The symbol to hash
+   *
+   * \return[PASS] The slot in the symbol table for this symbol
+   * \return[FAIL] SYMBOL_HASH_SIZE if the string can not be a symbol
+   */
+  [[nodiscard]] static constexpr inline std::size_t symbol_hash(const std::string_view symbol) noexcept
+  {
+    if (symbol.empty() || symbol.size() > 2 || symbol[0] < 'A' || symbol[0] > 'Z')
+      {
+        return SYMBOL_HASH_SIZE;
+      }
+
+    const auto first = static_cast<std::size_t>(symbol[0] - 'A') * 27;
+
+    if (symbol.size() == 1)
+      {
+        return first;
+      }
+
+    return (symbol[1] < 'a' || symbol[1] > 'z') ? SYMBOL_HASH_SIZE
+                                                : first + 1 + static_cast<std::size_t>(symbol[1] - 'a');
+  }
+
+  /// Z of every symbol stored in the slot given by symbol_hash(), defined, at compile time, after the class
+  static const std::array<uint8_t, SYMBOL_HASH_SIZE> symbolTable;
+
   /**
    * Get the hash of a const char* so we can use a switch statement on std::string_view
    * https://learnmoderncpp.com/2020/06/01/strings-as-switch-case-labels/
@@ -163,6 +253,28 @@ public:
    */
   [[nodiscard]] static std::optional<uint16_t> SymbolToZ(std::string_view symbol);
 
+  /**
+   * Convert a nuclide label, e.g. 208Pb, Pb208 or Pb-208, into it's mass and proton numbers.
+   * Leading and trailing spaces are ignored, but the symbol must be correctly capitalised.
+   *
+   * \param The label to convert
+   *
+   * \return[PASS] The mass and proton number, in that order
+   * \return[FAIL] An empty optional if the label is not a valid nuclide
+   */
+  [[nodiscard]] static std::optional<std::pair<uint16_t, uint16_t>> LabelToAZ(std::string_view label) noexcept;
+
+  /**
+   * Convert many nuclide labels into their mass and proton numbers, see LabelToAZ() for the accepted formats.
+   *
+   * \param The labels to convert
+   * \param Where to store the results, must be at least as long as the labels
+   *
+   * \return The number of labels that were converted successfully
+   */
+  static std::size_t LabelsToAZ(std::span<const std::string_view> labels,
+                                std::span<std::optional<std::pair<uint16_t, uint16_t>>> results) noexcept;
+
   /**
    * Convert any type from it's string(_view) representation to the given type.
    * If the string does not convert properly, return the max value of the type
@@ -286,9 +398,172 @@ public:
    * \return a std::chrono::duration represetning the value and unit given
    */
   [[nodiscard]] static std::chrono::duration<double> ToDuration(const double value, std::string_view unit) noexcept;
+
+  /**
+   * Convert a numeric value and it's unit to a chrono::duration.
+   *
+   * \param value The numeric value of the time
+   * \param unit The already decoded unit of the time
+   *
+   * \return a std::chrono::duration representing the value and unit given
+   */
+  [[nodiscard]] static constexpr std::chrono::duration<double> ToDuration(const double value,
+                                                                          const TimeUnit unit) noexcept
+  {
+    if (unit >= TimeUnit::UNKNOWN)
+      {
+        return seconds{ unknown_unit_seconds };
+      }
+
+    const auto& scale = timeScale[static_cast<std::size_t>(unit)];
+    return seconds{ scale.pre * value * scale.num / scale.den };
+  }
+
+  /**
+   * Decode the unit of a half life. Only the exact unit is accepted, i.e. no surrounding whitespace, and no more than
+   * the first 2 characters are ever read.
+   *
+   * \param The unit as given in the data file, e.g. ms, ky
+   *
+   * \return The matching TimeUnit, or TimeUnit::UNKNOWN if the unit is not recognised
+   */
+  [[nodiscard]] static constexpr TimeUnit ToTimeUnit(std::string_view unit) noexcept
+  {
+    if (unit.size() == 1)
+      {
+        switch (unit.front())
+          {
+            case 's':
+              return TimeUnit::SECONDS;
+            case 'm':
+              return TimeUnit::MINUTES;
+            case 'h':
+              return TimeUnit::HOURS;
+            case 'd':
+              return TimeUnit::DAYS;
+            case 'y':
+              return TimeUnit::YEARS;
+            default:
+              return TimeUnit::UNKNOWN;
+          }
+      }
+
+    if (unit.size() != 2)
+      {
+        return TimeUnit::UNKNOWN;
+      }
+
+    // Subdivisions of a second use a lower case prefix, multiples of a year mostly use upper case
+    if (unit.back() == 's')
+      {
+        switch (unit.front())
+          {
+            case 'y':
+              return TimeUnit::YOCTOSECONDS;
+            case 'z':
+              return TimeUnit::ZEPTOSECONDS;
+            case 'a':
+              return TimeUnit::ATTOSECONDS;
+            case 'p':
+              return TimeUnit::PICOSECONDS;
+            case 'n':
+              return TimeUnit::NANOSECONDS;
+            case 'u':
+              return TimeUnit::MICROSECONDS;
+            case 'm':
+              return TimeUnit::MILLISECONDS;
+            default:
+              return TimeUnit::UNKNOWN;
+          }
+      }
+
+    if (unit.back() == 'y')
+      {
+        switch (unit.front())
+          {
+            case 'k':
+              return TimeUnit::KILOYEARS;
+            case 'M':
+              return TimeUnit::MILLIONYEARS;
+            case 'G':
+              return TimeUnit::BILLIONYEARS;
+            case 'T':
+              return TimeUnit::TERAYEARS;
+            case 'P':
+              return TimeUnit::PETAYEARS;
+            case 'E':
+              return TimeUnit::EXAYEARS;
+            case 'Z':
+              return TimeUnit::ZETTAYEARS;
+            case 'Y':
+              return TimeUnit::YOTTAYEARS;
+            default:
+              return TimeUnit::UNKNOWN;
+          }
+      }
+
+    return TimeUnit::UNKNOWN;
+  }
+
+  /**
+   * Get the unit as it is written in the data file, the reverse of ToTimeUnit()
+   *
+   * \param The unit
+   *
+   * \return The unit as a string, empty if it is TimeUnit::UNKNOWN
+   */
+  [[nodiscard]] static constexpr std::string_view TimeUnitToString(const TimeUnit unit) noexcept
+  {
+    constexpr std::array<std::string_view, static_cast<std::size_t>(TimeUnit::UNKNOWN) + 1> names{
+      "ys", "zs", "as", "ps", "ns", "us", "ms", "s",  "m",  "h", "d",
+      "y",  "ky", "My", "Gy", "Ty", "Py", "Ey", "Zy", "Yy", ""
+    };
+
+    return names[std::min(static_cast<std::size_t>(unit), names.size() - 1)];
+  }
+
+  /**
+   * Convert columns of numeric values and their units to seconds. The conversion of each element is identical to
+   * ToDuration(), but there are no branches so the compiler is able to vectorise the loop.
+   *
+   * \param The numeric values
+   * \param The unit of each value, decoded with ToTimeUnit()
+   * \param Where to store the values in seconds
+   *
+   * \return The number of values converted, the length of the shortest of the 3 inputs
+   */
+  static std::size_t ToSeconds(std::span<const double> values,
+                               std::span<const TimeUnit> units,
+                               std::span<double> in_seconds) noexcept;
 };
 
 
+inline constexpr std::array<uint8_t, Converter::SYMBOL_HASH_SIZE> Converter::symbolTable = []() {
+  std::array<uint8_t, SYMBOL_HASH_SIZE> table{};
+  table.fill(NO_ELEMENT);
+
+  // Skip the neutron, it doesn't follow the same format as the elements
+  for (std::size_t Z = 1; Z < symbolZmap.size(); ++Z)
+    {
+      table[symbol_hash(symbolZmap[Z].first)] = static_cast<uint8_t>(symbolZmap[Z].second);
+    }
+
+  return table;
+}();
+
+
+inline constexpr std::array<Converter::TimeScale, static_cast<std::size_t>(Converter::TimeUnit::UNKNOWN) + 1>
+    Converter::timeScale{
+      make_scale<attoseconds>(1.0e-6),  make_scale<attoseconds>(1.0e-3),  make_scale<attoseconds>(),
+      make_scale<picoseconds>(),        make_scale<nanoseconds>(),        make_scale<microseconds>(),
+      make_scale<milliseconds>(),       make_scale<seconds>(),            make_scale<minutes>(),
+      make_scale<hours>(),              make_scale<days>(),               make_scale<years>(),
+      make_scale<kiloyears>(),          make_scale<millionyears>(),       make_scale<billionyears>(),
+      make_scale<billionyears>(1.0e3),  make_scale<billionyears>(1.0e6),  make_scale<billionyears>(1.0e9),
+      make_scale<billionyears>(1.0e12), make_scale<billionyears>(1.0e15), TimeScale{ 0.0, 0.0, 1.0 }
+    };
+
+
 /// string literal to force the hashing of the string
 [[nodiscard]] constexpr inline auto operator"" _sh(const char* the_string, [[maybe_unused]] std::size_t unused)
 {
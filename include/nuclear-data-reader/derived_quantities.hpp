@@ -0,0 +1,251 @@
+/**
+ *
+ * \class DerivedQuantities
+ *
+ * \brief Calculate separation energies and Q-values, for the whole chart, from the AME mass excesses
+ *
+ * The reaction files only give values where the AME authors tabulated them. Every one of those values is a sum of mass
+ * excesses, so can be recalculated, consistently, for every isotope with a mass, including those that are
+ * extrapolated, and for combinations that are not in the files at all.
+ *
+ * The mass excess and its uncertainty are copied into columns laid out as a grid over (Z, N), with a border of
+ * missing (NaN) values wide enough that a formula can reach any neighbour without a bounds check. Each term of a
+ * formula is then a single loop over the whole grid, shifted by a fixed offset, that the compiler can vectorise. A
+ * missing neighbour makes the result NaN, i.e. missing, without any special handling.
+ *
+ * Uncertainties are added in quadrature, treating the masses as uncorrelated. AME accounts for the correlations
+ * between masses, so its uncertainties can be smaller than those calculated here, while the values agree.
+ *
+ * The same sweeps give the finite difference indicators of nuclear structure, pairing gaps, shell gaps, the
+ * proton-neutron interaction and the slope of S_2n, for the whole chart at once.
+ */
+#ifndef DERIVED_QUANTITIES_HPP
+#define DERIVED_QUANTITIES_HPP
+
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+class DerivedQuantities
+{
+public:
+  /**
+   * Copy the mass excesses out of a table. Use every isotope in MassTable::ameDataTable, not only those that were
+   * merged. If the AME mass excess was not wanted when the table was populated, every mass is missing.
+   *
+   * \param The populated table
+   */
+  explicit DerivedQuantities(const MassTable& table);
+
+  DerivedQuantities(const DerivedQuantities&)     = default;
+  DerivedQuantities(DerivedQuantities&&) noexcept = default;
+
+  DerivedQuantities& operator=(const DerivedQuantities&)     = default;
+  DerivedQuantities& operator=(DerivedQuantities&&) noexcept = default;
+
+  ~DerivedQuantities() = default;
+
+  /// How far, in either Z or N, a formula can reach from the isotope it is calculated for
+  static constexpr int16_t REACH{ 4 };
+
+  /**
+   * \enum Indicator
+   *
+   * \brief Indicators of nuclear structure that are finite differences of the masses
+   *
+   * Formulae are given in terms of the binding energy B, and are defined so that the gaps and the proton-neutron
+   * interaction are positive for typical nuclei.
+   */
+  enum class Indicator : uint8_t
+  {
+    /// Three point odd-even staggering in N, (-1)^N [2B(N) - B(N+1) - B(N-1)] / 2
+    PAIRING_GAP_3N,
+    /// Three point odd-even staggering in Z
+    PAIRING_GAP_3P,
+    /// Five point odd-even staggering in N, (-1)^N [B(N+2) - 4B(N+1) + 6B(N) - 4B(N-1) + B(N-2)] / 8
+    PAIRING_GAP_5N,
+    /// Five point odd-even staggering in Z
+    PAIRING_GAP_5P,
+    /// Two neutron shell gap, S_2n(Z, N) - S_2n(Z, N+2)
+    SHELL_GAP_2N,
+    /// Two proton shell gap, S_2p(Z, N) - S_2p(Z+2, N)
+    SHELL_GAP_2P,
+    /// Interaction of the last protons with the last neutrons, [B(Z, N) - B(Z, N-2) - B(Z-2, N) + B(Z-2, N-2)] / 4
+    /// for even-even nuclei, with steps of 1, and a divisor to match, for Z or N that is odd
+    DELTA_VPN,
+    /// Slope of S_2n along N, [S_2n(N+2) - S_2n(N-2)] / 4
+    S2N_DERIVATIVE
+  };
+
+  /**
+   * \struct Term
+   *
+   * \brief One mass excess in the sum that gives a quantity
+   */
+  struct Term
+  {
+    /// Offset from the isotope, or if not relative the position of a fixed nuclide e.g. (0, 1) for the neutron
+    int16_t Z{ 0 };
+    int16_t N{ 0 };
+    /// How many times the mass excess is added, negative to subtract it
+    int8_t coefficient{ 1 };
+    /// Is the position an offset from the isotope
+    bool relative{ true };
+  };
+
+  /**
+   * \struct Column
+   *
+   * \brief A quantity calculated for every position on the chart
+   */
+  struct Column
+  {
+    /// In the same layout as the grid of mass excesses, NaN where the quantity can not be calculated
+    std::vector<double> value;
+    std::vector<double> error;
+  };
+
+  /**
+   * \struct Mismatch
+   *
+   * \brief An isotope where the calculated value does not agree with the one in the data file
+   */
+  struct Mismatch
+  {
+    uint16_t A{ 0 };
+    uint16_t Z{ 0 };
+    Number derived{};
+    Number tabulated{};
+  };
+
+  /**
+   * The formula used to calculate each quantity from the masses
+   *
+   * \param The quantity
+   *
+   * \return The terms of the formula, empty if the quantity is not a sum of masses
+   */
+  [[nodiscard]] static std::vector<Term> formula(const Quantity quantity);
+
+  /**
+   * The largest Z of an isotope with a mass
+   *
+   * \param Nothing
+   *
+   * \return Z
+   */
+  [[nodiscard]] inline uint16_t getZmax() const noexcept { return Zmax; }
+
+  /**
+   * The largest N of an isotope with a mass
+   *
+   * \param Nothing
+   *
+   * \return N
+   */
+  [[nodiscard]] inline uint16_t getNmax() const noexcept { return Nmax; }
+
+  /**
+   * Calculate a quantity for every position on the chart
+   *
+   * \param The terms of the formula
+   *
+   * \return[PASS] The quantity
+   * \return[FAIL] An empty optional if a term reaches further than REACH, or the formula is empty
+   */
+  [[nodiscard]] std::optional<Column> calculate(std::span<const Term> terms) const;
+
+  /**
+   * Calculate one of the quantities that is a sum of masses for every position on the chart
+   *
+   * \param The quantity
+   *
+   * \return[PASS] The quantity
+   * \return[FAIL] An empty optional if the quantity is not a sum of masses
+   */
+  [[nodiscard]] inline std::optional<Column> calculate(const Quantity quantity) const
+  {
+    return calculate(formula(quantity));
+  }
+
+  /**
+   * Calculate an indicator of nuclear structure for every position on the chart
+   *
+   * \param The indicator
+   *
+   * \return[PASS] The indicator
+   * \return[FAIL] An empty optional if there are no masses
+   */
+  [[nodiscard]] std::optional<Column> calculate(const Indicator indicator) const;
+
+  /**
+   * Get the value of a calculated quantity for a single isotope
+   *
+   * \param The calculated quantity
+   * \param The proton number
+   * \param The neutron number
+   *
+   * \return[PASS] The value and its uncertainty
+   * \return[FAIL] An empty optional if the value could not be calculated
+   */
+  [[nodiscard]] std::optional<Number> at(const Column& column, const uint16_t Z, const uint16_t N) const;
+
+  /**
+   * Compare a calculated quantity with the values read from the AME files. Only isotopes with both values are
+   * compared. The reaction files must have been read.
+   *
+   * \param The table the masses were copied from
+   * \param The quantity
+   * \param How many combined standard deviations the values may differ by
+   *
+   * \return The isotopes where the values differ by more than allowed, in the order of MassTable::fullDataTable
+   */
+  [[nodiscard]] std::vector<Mismatch>
+  crossCheck(const MassTable& table, const Quantity quantity, const double sigmas = 3.0) const;
+
+private:
+  /// The largest Z and N with a mass
+  uint16_t Zmax{ 0 };
+  uint16_t Nmax{ 0 };
+  /// Number of slots in each row (Z value) of the grid, including the border on both sides
+  std::size_t width{ 0 };
+
+  /// The mass excess, in keV, of each (Z, N)
+  std::vector<double> mass_excess;
+  /// The square of the uncertainty on each mass excess
+  std::vector<double> variance;
+
+  /**
+   * Where a position on the chart is in the grid
+   *
+   * \param The proton number, may be negative
+   * \param The neutron number, may be negative
+   *
+   * \return The index of the slot in the grid
+   */
+  [[nodiscard]] inline std::size_t slot(const int Z, const int N) const noexcept
+  {
+    return static_cast<std::size_t>(Z + REACH) * width + static_cast<std::size_t>(N + REACH);
+  }
+
+  /**
+   * Combine calculated columns, choosing which by whether Z and N are odd or even, and scale each value by a factor
+   * that also depends on it. Uncertainties are scaled by the size of the factor.
+   *
+   * \param The column for each combination, in the order (even Z, even N), (even, odd), (odd, even), (odd, odd)
+   * \param The factor for each combination, in the same order
+   *
+   * \return The combined column, missing outside of the chart
+   */
+  [[nodiscard]] Column combine(const std::array<const Column*, 4>& columns, const std::array<double, 4>& factors) const;
+};
+
+#endif // DERIVED_QUANTITIES_HPP
@@ -0,0 +1,232 @@
+/**
+ *
+ * \class Diagnostics
+ *
+ * \brief Route the messages produced while reading and writing tables to somewhere the user chooses
+ *
+ * Every message is a structured Diagnostic, with a severity, a code saying what happened and, where they are known,
+ * the file, line and isotope it is about. Messages are passed to a DiagnosticSink, by default one that prints them
+ * to the console. Removing the sink makes the table silent, every message is then only counted. The text of a
+ * message is only created if there is a sink that wants it, so a silent table does no formatting, locking or I/O.
+ */
+#ifndef DIAGNOSTICS_HPP
+#define DIAGNOSTICS_HPP
+
+#include <string_view>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+
+/// How important a message is
+enum class Severity : uint8_t
+{
+  /// Progress through the file, or a file that has been written
+  INFO = 0,
+  /// Something was not as expected, but we can continue
+  WARNING = 1,
+  /// Something could not be done
+  ERROR = 2
+};
+
+
+/// What the message is about
+enum class DiagnosticCode : uint8_t
+{
+  /// Reading, or merging, has started or finished
+  PROGRESS = 0,
+  /// A new file has been written
+  FILE_WRITTEN = 1,
+  /// The data file does not exist
+  FILE_NOT_FOUND = 2,
+  /// Values that should have been read were not
+  NOT_READ = 3,
+  /// A line of a reaction file has no matching isotope in the mass table
+  NO_MATCHING_ISOTOPE = 4,
+  /// No mass data has been read for the given A and Z
+  NO_MATCHING_MASS_DATA = 5,
+  /// An isomer was read before its ground state
+  NO_GROUND_STATE = 6,
+  /// The AME and NUBASE tables contain a different number of isotopes
+  TABLE_SIZE_MISMATCH = 7,
+  /// A step was attempted before a step that it depends on
+  OUT_OF_ORDER = 8,
+  /// A file could not be opened, or was not completely written
+  FILE_NOT_WRITTEN = 9
+};
+
+
+/**
+ * \struct Diagnostic
+ *
+ * \brief A single message, along with what it is about
+ */
+struct Diagnostic
+{
+  Severity severity{ Severity::INFO };
+  DiagnosticCode code{ DiagnosticCode::PROGRESS };
+  /// The file the message is about, nullptr if it is not about a file
+  const std::filesystem::path* file{ nullptr };
+  /// The line of the file the message is about, 0 if it is not about a single line
+  uint32_t line_number{ 0 };
+  /// The mass number of the isotope the message is about, 0 if it is not about an isotope
+  uint16_t A{ 0 };
+  /// The proton number of the isotope the message is about
+  uint16_t Z{ 0 };
+  /// Human readable version of the message, only valid for the duration of DiagnosticSink::report()
+  std::string_view message{};
+};
+
+
+class DiagnosticSink
+{
+public:
+  DiagnosticSink() = default;
+
+  DiagnosticSink(const DiagnosticSink&)     = default;
+  DiagnosticSink(DiagnosticSink&&) noexcept = default;
+
+  DiagnosticSink& operator=(const DiagnosticSink&)     = default;
+  DiagnosticSink& operator=(DiagnosticSink&&) noexcept = default;
+
+  virtual ~DiagnosticSink() = default;
+
+  /**
+   * Do something with a message. May be called from more than one thread if tables are loaded in parallel.
+   *
+   * \param The message
+   *
+   * \return Nothing
+   */
+  virtual void report(const Diagnostic& diagnostic) = 0;
+};
+
+
+/**
+ * \class ConsoleSink
+ *
+ * \brief Print the text of every message, information to stdout and warnings and errors to stderr
+ */
+class ConsoleSink final : public DiagnosticSink
+{
+public:
+  void report(const Diagnostic& diagnostic) override;
+
+  /**
+   * The console sink that every table uses by default
+   *
+   * \param Nothing
+   *
+   * \return The sink
+   */
+  [[nodiscard]] static ConsoleSink& instance();
+};
+
+
+class Diagnostics
+{
+public:
+  Diagnostics() = default;
+
+  // A copy gets the same sink and threshold, and a snapshot of the counts
+  Diagnostics(const Diagnostics& other) noexcept : sink(other.sink), threshold(other.threshold)
+  {
+    copyCounts(other);
+  }
+  Diagnostics& operator=(const Diagnostics& other) noexcept
+  {
+    sink      = other.sink;
+    threshold = other.threshold;
+    copyCounts(other);
+    return *this;
+  }
+
+  ~Diagnostics() = default;
+
+  /// Where messages are sent, not owned. Set to nullptr to only count the messages.
+  DiagnosticSink* sink{ &ConsoleSink::instance() };
+  /// Messages less severe than this are only counted
+  Severity threshold{ Severity::INFO };
+
+  /**
+   * Stop sending messages anywhere, they will still be counted
+   *
+   * \param Nothing
+   *
+   * \return Nothing
+   */
+  inline void silence() noexcept { sink = nullptr; }
+
+  /**
+   * Will a message of this severity be sent to the sink
+   *
+   * \param The severity of the message
+   *
+   * \return[TRUE] The message will be sent to the sink
+   * \return[FALSE] The message will only be counted
+   */
+  [[nodiscard]] inline bool accepts(const Severity severity) const noexcept
+  {
+    return sink != nullptr && severity >= threshold;
+  }
+
+  /**
+   * Count a message and, if it is wanted, create its text and send it to the sink
+   *
+   * \param The details of the message, without the text
+   * \param A callable that returns the text of the message, only called if the message is sent to the sink
+   *
+   * \return Nothing
+   */
+  template<typename MakeMessage>
+  void report(Diagnostic diagnostic, MakeMessage&& make_message) const
+  {
+    counts[static_cast<std::size_t>(diagnostic.severity)].fetch_add(1, std::memory_order_relaxed);
+
+    if (!accepts(diagnostic.severity))
+      {
+        return;
+      }
+
+    const std::string message{ make_message() };
+    diagnostic.message = message;
+    sink->report(diagnostic);
+  }
+
+  /**
+   * The number of messages of a given severity, whether or not they were sent to the sink
+   *
+   * \param The severity
+   *
+   * \return The number of messages
+   */
+  [[nodiscard]] inline uint32_t count(const Severity severity) const noexcept
+  {
+    return counts[static_cast<std::size_t>(severity)].load(std::memory_order_relaxed);
+  }
+
+private:
+  /// One counter for each Severity
+  mutable std::array<std::atomic<uint32_t>, 3> counts{};
+
+  /**
+   * Take a copy of the counts of another instance
+   *
+   * \param The instance to copy from
+   *
+   * \return Nothing
+   */
+  inline void copyCounts(const Diagnostics& other) noexcept
+  {
+    for (std::size_t i = 0; i < counts.size(); ++i)
+      {
+        counts[i].store(other.counts[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+  }
+};
+
+#endif // DIAGNOSTICS_HPP
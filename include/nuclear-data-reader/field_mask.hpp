@@ -0,0 +1,123 @@
+/**
+ *
+ * \class FieldMask
+ *
+ * \brief Select which values are extracted when the data files are parsed
+ *
+ * Parsing every value on every line is wasted effort if only a few of them are used. Setting a mask on the
+ * MassTable before it is populated allows the extraction of all other values to be skipped. The A, Z, N, state and
+ * experimental flag of each isotope, along with any isomeric energies, are always read. Values that are not read are
+ * stored as Number::MISSING, so they are written as null rather than mistaken for a measured zero.
+ */
+#ifndef FIELDMASK_HPP
+#define FIELDMASK_HPP
+
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+
+/// Values read from the data files that are not numerical, so aren't covered by Quantity
+enum class Property : uint8_t
+{
+  /// Spin, parity and if they have been measured
+  SPIN_PARITY = 0,
+  /// The main decay mode, along with the proton/neutron rich flag that depends on it
+  DECAY_MODE = 1,
+  /// The year the isotope was discovered
+  DISCOVERY_YEAR = 2
+};
+
+
+class FieldMask
+{
+public:
+  /// By default, every value is wanted
+  FieldMask()
+  {
+    quantities.set();
+    properties.set();
+  }
+
+  FieldMask(const std::initializer_list<Quantity> _quantities, const std::initializer_list<Property> _properties = {})
+  {
+    for (const auto quantity : _quantities)
+      {
+        quantities.set(static_cast<std::size_t>(quantity));
+      }
+
+    for (const auto property : _properties)
+      {
+        properties.set(static_cast<std::size_t>(property));
+      }
+  }
+
+  FieldMask(const FieldMask&)     = default;
+  FieldMask(FieldMask&&) noexcept = default;
+
+  FieldMask& operator=(const FieldMask&)     = default;
+  FieldMask& operator=(FieldMask&&) noexcept = default;
+
+  ~FieldMask() = default;
+
+  /// One bit per quantity, set if it should be read
+  std::bitset<all_quantities.size()> quantities{};
+  /// One bit per property, set if it should be read
+  std::bitset<3> properties{};
+
+  /**
+   * Should the quantity be read
+   *
+   * \param The quantity
+   *
+   * \return[TRUE] The quantity is wanted
+   * \return[FALSE] The quantity can be skipped
+   */
+  [[nodiscard]] inline bool wants(const Quantity value) const { return quantities.test(static_cast<std::size_t>(value)); }
+
+  /**
+   * Should the property be read
+   *
+   * \param The property
+   *
+   * \return[TRUE] The property is wanted
+   * \return[FALSE] The property can be skipped
+   */
+  [[nodiscard]] inline bool wants(const Property value) const { return properties.test(static_cast<std::size_t>(value)); }
+
+  /**
+   * Is at least one of the values in the first reaction file (rct1) wanted
+   *
+   * \param Nothing
+   *
+   * \return[TRUE] The file needs to be read
+   * \return[FALSE] The file can be skipped
+   */
+  [[nodiscard]] inline bool wantsReactionOne() const
+  {
+    return std::any_of(reaction_1_quantities.cbegin(), reaction_1_quantities.cend(), [this](const auto quantity) {
+      return wants(quantity);
+    });
+  }
+
+  /**
+   * Is at least one of the values in the second reaction file (rct2) wanted
+   *
+   * \param Nothing
+   *
+   * \return[TRUE] The file needs to be read
+   * \return[FALSE] The file can be skipped
+   */
+  [[nodiscard]] inline bool wantsReactionTwo() const
+  {
+    return std::any_of(reaction_2_quantities.cbegin(), reaction_2_quantities.cend(), [this](const auto quantity) {
+      return wants(quantity);
+    });
+  }
+};
+
+#endif // FIELDMASK_HPP
@@ -12,6 +12,8 @@
 
 #include "nuclear-data-reader/ame_data.hpp"
 #include "nuclear-data-reader/nubase_data.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
 
 #include <cstdint>
 #include <string>
@@ -40,6 +42,16 @@ public:
   // All of the NUBASE data
   mutable NUBASE::Data nubase;
 
+  /**
+   * Get one of the numerical values of the isotope, along with it's uncertainty.
+   * The half-life, and it's error, are given in seconds.
+   *
+   * \param Which value to get
+   *
+   * \return The value as a Number
+   */
+  [[nodiscard]] Number getQuantity(const Quantity quantity) const;
+
   /**
    * Output all of the data as a csv string
    *
@@ -0,0 +1,214 @@
+/**
+ *
+ * \class LoadStats
+ *
+ * \brief Timings and counters recorded as a MassTable is populated
+ *
+ * Each file that is read, and the merging of the data from them, is a separate phase. For every phase we record how
+ * long it took, how much of the file was read and what came out of it, so a load can be monitored without parsing
+ * the progress messages. Writing the table to file is also recorded, as a phase per format.
+ *
+ * Allocations are only counted if an AllocationProbe is given, the library does not count them itself. The probe is
+ * read at the start and end of each phase, so can be backed by anything, e.g. a replaced global operator new or a
+ * counting std::pmr::memory_resource.
+ */
+#ifndef LOADSTATS_HPP
+#define LOADSTATS_HPP
+
+#include <string_view>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+
+/// The steps taken when a MassTable is populated
+enum class LoadPhase : uint8_t
+{
+  /// Reading the AME mass file
+  AME_MASS = 0,
+  /// Reading the first AME reaction file
+  AME_REACTION_1 = 1,
+  /// Reading the second AME reaction file
+  AME_REACTION_2 = 2,
+  /// Reading the NUBASE file
+  NUBASE = 3,
+  /// Combining the AME and NUBASE data into the full table
+  MERGE = 4,
+  /// Writing the full table as json
+  EXPORT_JSON = 5,
+  /// Writing the full table as csv
+  EXPORT_CSV = 6
+};
+
+
+/**
+ * \struct AllocationCount
+ *
+ * \brief Running totals of an allocation counter
+ */
+struct AllocationCount
+{
+  /// Number of allocations made
+  uint64_t allocations{ 0 };
+  /// Number of bytes requested by those allocations
+  uint64_t bytes{ 0 };
+};
+
+/// Read the current totals of an allocation counter, must be safe to call from any thread that loads a table
+using AllocationProbe = AllocationCount (*)() noexcept;
+
+
+/**
+ * \struct PhaseStats
+ *
+ * \brief What happened during a single phase of the load
+ */
+struct PhaseStats
+{
+  /// How long the phase took
+  std::chrono::nanoseconds wall_time{ 0 };
+  /// Lines of the file that were read, including those that were skipped
+  uint32_t lines_read{ 0 };
+  /// Lines that were read, but did not contain data, e.g. headers
+  uint32_t lines_skipped{ 0 };
+  /// Entries added to, or updated in, the data table the phase fills
+  uint32_t records{ 0 };
+  /// Lines, or entries, that have no matching isotope in the data already read
+  uint32_t unmatched{ 0 };
+  /// Size of the lines that were read, including the new line character
+  uint64_t bytes_read{ 0 };
+  /// Allocations made during the phase, only counted if an AllocationProbe was given
+  uint64_t allocations{ 0 };
+  /// Bytes requested by those allocations
+  uint64_t allocated_bytes{ 0 };
+
+  /**
+   * Record that a line has been read
+   *
+   * \param The size of the line, including the new line character
+   *
+   * \return Nothing
+   */
+  inline void addLine(const std::size_t bytes) noexcept
+  {
+    ++lines_read;
+    bytes_read += bytes;
+  }
+};
+
+
+class LoadStats
+{
+public:
+  LoadStats() = default;
+
+  LoadStats(const LoadStats&)     = default;
+  LoadStats(LoadStats&&) noexcept = default;
+
+  LoadStats& operator=(const LoadStats&)     = default;
+  LoadStats& operator=(LoadStats&&) noexcept = default;
+
+  ~LoadStats() = default;
+
+  /// Names of the phases, in the order of LoadPhase
+  static constexpr std::array<std::string_view, 7> phase_names{
+    "AME mass", "AME reaction 1", "AME reaction 2", "NUBASE", "merge", "export json", "export csv"
+  };
+
+  /// One entry per phase, in the order of LoadPhase
+  std::array<PhaseStats, phase_names.size()> phases{};
+  /// Number of excited states that were attached to their ground state
+  uint32_t isomers_attached{ 0 };
+
+  /**
+   * Get the stats of a single phase
+   *
+   * \param The phase
+   *
+   * \return The stats of that phase
+   */
+  [[nodiscard]] inline PhaseStats& operator[](const LoadPhase phase) noexcept
+  {
+    return phases[static_cast<std::size_t>(phase)];
+  }
+
+  /**
+   * Get the stats of a single phase
+   *
+   * \param The phase
+   *
+   * \return The stats of that phase
+   */
+  [[nodiscard]] inline const PhaseStats& operator[](const LoadPhase phase) const noexcept
+  {
+    return phases[static_cast<std::size_t>(phase)];
+  }
+
+  /**
+   * Get the name of a phase, e.g. to label exported metrics
+   *
+   * \param The phase
+   *
+   * \return The name of the phase
+   */
+  [[nodiscard]] static constexpr std::string_view name(const LoadPhase phase) noexcept
+  {
+    return phase_names[static_cast<std::size_t>(phase)];
+  }
+
+  /**
+   * The time taken by all of the phases
+   *
+   * \param Nothing
+   *
+   * \return The total time
+   */
+  [[nodiscard]] inline std::chrono::nanoseconds totalWallTime() const noexcept
+  {
+    std::chrono::nanoseconds total{ 0 };
+    for (const auto& phase : phases)
+      {
+        total += phase.wall_time;
+      }
+    return total;
+  }
+
+  /**
+   * \struct Timer
+   *
+   * \brief Add the time, and allocations, between construction and destruction to a phase
+   */
+  struct Timer
+  {
+    explicit Timer(PhaseStats& _stats, const AllocationProbe _probe = nullptr) :
+        stats(_stats), probe(_probe), allocated(probe ? probe() : AllocationCount{})
+    {
+    }
+
+    Timer(const Timer&)            = delete;
+    Timer(Timer&&)                 = delete;
+    Timer& operator=(const Timer&) = delete;
+    Timer& operator=(Timer&&)      = delete;
+
+    ~Timer()
+    {
+      stats.wall_time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+      if (probe != nullptr)
+        {
+          const auto now = probe();
+          stats.allocations += now.allocations - allocated.allocations;
+          stats.allocated_bytes += now.bytes - allocated.bytes;
+        }
+    }
+
+    PhaseStats& stats;
+    AllocationProbe probe{ nullptr };
+    AllocationCount allocated{};
+    std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+  };
+};
+
+#endif // LOADSTATS_HPP
@@ -10,16 +10,33 @@
 #define MASSTABLE_HPP
 
 #include "nuclear-data-reader/ame_data.hpp"
+#include "nuclear-data-reader/chart_index.hpp"
+#include "nuclear-data-reader/diagnostics.hpp"
+#include "nuclear-data-reader/field_mask.hpp"
 #include "nuclear-data-reader/isotope.hpp"
+#include "nuclear-data-reader/load_stats.hpp"
 #include "nuclear-data-reader/nubase_data.hpp"
+#include "nuclear-data-reader/nubase_decay_branch.hpp"
+#include "nuclear-data-reader/nubase_isomer_table.hpp"
+#include "nuclear-data-reader/nuclide_key.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 
@@ -79,10 +96,86 @@ public:
   /// The AME reaction_2 file path
   mutable std::filesystem::path AME_reaction_2{};
 
+  /// Which values should be extracted from the data files, must be set before the table is populated
+  mutable FieldMask fields{};
+
+  /// Where progress, warning and error messages are sent, must be set before the table is populated
+  mutable Diagnostics diagnostics{};
+
+  /// How much of the AME data is read when the table is populated
+  enum class LoadMode : uint8_t
+  {
+    /// Read the mass file and both reaction files
+    EAGER = 0,
+    /// Read the mass file, but only read the reaction files when a reaction value is first requested
+    LAZY_REACTIONS = 1
+  };
+  /// Which load mode to use, must be set before the table is populated
+  mutable LoadMode load_mode{ LoadMode::EAGER };
+
+  /// In which form, if any, the isomeric states are written alongside the main table
+  enum class IsomerExport : uint8_t
+  {
+    /// Only write the main table
+    NONE = 0,
+    /// Newline delimited json alongside the json table and csv alongside the csv table
+    TEXT = 1,
+    /// Fixed size binary records alongside either table
+    BINARY = 2
+  };
+  /// How the isomeric states are exported, one row per state that can be joined to the main table by (A, Z)
+  mutable IsomerExport isomer_export{ IsomerExport::NONE };
+
+  /**
+   * \struct LoadOnce
+   *
+   * \brief Thread safe, one time, reading of data that has been deferred
+   *
+   * std::once_flag can be neither copied or moved, wrap it so that the table still can be.
+   * A copy, or an assignment, gets a new flag, but keeps the pending state and the result so the work is only done if
+   * it is still required. Assigning a default constructed instance starts again, as if nothing had been deferred.
+   */
+  struct LoadOnce
+  {
+    LoadOnce() = default;
+    LoadOnce(const LoadOnce& other) : pending(other.pending.load()), succeeded(other.succeeded.load()) {}
+    LoadOnce& operator=(const LoadOnce& other)
+    {
+      flag = std::make_unique<std::once_flag>();
+      pending.store(other.pending.load());
+      succeeded.store(other.succeeded.load());
+      return *this;
+    }
+    ~LoadOnce() = default;
+
+    /// Held by pointer so that a flag that has fired can be replaced
+    std::unique_ptr<std::once_flag> flag{ std::make_unique<std::once_flag>() };
+    std::atomic<bool> pending{ false };
+    /// Did the deferred work succeed, given to every caller not only the one that did it
+    std::atomic<bool> succeeded{ true };
+  };
+  /// The reaction files are waiting to be read
+  mutable LoadOnce reaction_load{};
+
   /// Container to store all of the data used to create the file
   mutable std::vector<Isotope> fullDataTable;
   mutable std::vector<NUBASE::Data> nubaseDataTable;
   mutable std::vector<AME::Data> ameDataTable;
+  /// Positions in ameDataTable sorted by key, so the reaction files and NUBASE data can be joined to it
+  mutable std::vector<std::pair<NuclideKey, uint32_t>> ame_index;
+  /// Positions in nubaseDataTable sorted by key
+  mutable std::vector<std::pair<NuclideKey, uint32_t>> nubase_index;
+  /// Locate isotopes in fullDataTable by their position on the chart
+  mutable ChartIndex chart_index{};
+  /// Every decay branch of every isotope, row i holds the branches of nubaseDataTable[i]
+  mutable NUBASE::DecayBranchTable decay_branches{};
+  /// Every excited state of every isotope, located from the ground states in nubaseDataTable
+  mutable NUBASE::IsomerTable isomers{};
+  /// What happened while the table was populated, reset by each call to populateInternalMassTable().
+  /// Deferred reaction files add to it when they are read, so only read it once the table is no longer changing.
+  mutable LoadStats load_stats{};
+  /// Read at the start and end of each phase to count the allocations made during it, nothing is counted if not set
+  mutable AllocationProbe allocation_probe{ nullptr };
 
 
   /**
@@ -119,11 +212,148 @@ public:
   }
 
   /**
+   * Read the AME mass file and, depending on the load mode, the two reaction files
    *
+   * \param Nothing
    *
-   **/
+   * \return[TRUE] Always
+   */
   bool readAME() const;
 
+  /**
+   * Read whichever of the AME reaction files contain wanted values
+   *
+   * \param Nothing
+   *
+   * \return[TRUE] The wanted files have been read without issue
+   * \return[FALSE] There was an issue reading at least one of the reaction files
+   */
+  bool readAMEReactionFiles() const;
+
+  /**
+   * Read the AME reaction files if they were deferred when the table was populated.
+   * Safe to call from multiple threads, the files are only read once, and does nothing if they have already been read.
+   * Only the reaction values of the merged isotopes are written, so other values can be read at the same time, but
+   * any thread that reads a reaction value must call this first.
+   *
+   * \param Nothing
+   *
+   * \return[TRUE] The reaction values are available
+   * \return[FALSE] There was an issue reading at least one of the reaction files
+   */
+  bool readDeferredReactions() const;
+
+  /**
+   * Copy the values read from the reaction files into the isotopes that have already been merged. Only the reaction
+   * values are written, nothing else in the isotopes is changed.
+   *
+   * \param Nothing
+   *
+   * \return Nothing
+   */
+  void updateMergedReactionData() const;
+
+  /**
+   * Index the merged table by Z and N. Done automatically when the table is populated,
+   * but needs to be called again if fullDataTable is modified.
+   *
+   * \param Nothing
+   *
+   * \return Nothing
+   */
+  inline void buildIndex() const { chart_index.build(fullDataTable); }
+
+  /**
+   * Index ameDataTable by key. Done once the mass file has been read, and by findAME() if ameDataTable has changed
+   * size since.
+   *
+   * \param Nothing
+   *
+   * \return Nothing
+   */
+  void indexAME() const;
+
+  /**
+   * Calculate the proton-neutron interaction, AME::Data::dV_pn, of every entry in ameDataTable from the mass excesses.
+   * Done once the mass file has been read, if the AME mass excess is wanted. Only the first entry of each isotope is
+   * set, the value is missing where it can not be calculated.
+   *
+   * \param Nothing
+   *
+   * \return Nothing
+   */
+  void setDeltaVpn() const;
+
+  /**
+   * Index nubaseDataTable by key. Done once the NUBASE file has been read, and by getDecayBranches() if
+   * nubaseDataTable has changed size since.
+   *
+   * \param Nothing
+   *
+   * \return Nothing
+   */
+  void indexNUBASE() const;
+
+  /**
+   * Find the first entry of ameDataTable with the given key, using the index. The index is rebuilt if the table has
+   * changed size, or if the entries next to where the key would be no longer have the keys they were indexed with.
+   *
+   * \param The key of the isotope
+   *
+   * \return An iterator to the entry, ameDataTable.end() if there isn't one
+   */
+  [[nodiscard]] std::vector<AME::Data>::iterator findAME(const NuclideKey key) const;
+
+  /**
+   * Get all of the isotopes in a rectangular region of the chart, boundaries are inclusive.
+   * Deferred reaction files are not read, call readDeferredReactions() first if the reaction values are needed.
+   *
+   * \param The minimum proton number
+   * \param The maximum proton number
+   * \param The minimum neutron number
+   * \param The maximum neutron number
+   *
+   * \return Pointers to the isotopes in fullDataTable, ordered by Z then N
+   */
+  [[nodiscard]] std::vector<const Isotope*>
+  getRegion(const uint16_t Zmin, const uint16_t Zmax, const uint16_t Nmin, const uint16_t Nmax) const;
+
+  /**
+   * Find many isotopes at once. Each key is found with a single access of the chart index, which is fetched ahead of
+   * time along with the isotope and the slot of the result, so the cost per key is small and mostly hidden.
+   * Deferred reaction files are not read, call readDeferredReactions() first if the reaction values are needed.
+   *
+   * \param The keys of the isotopes, the level of each key is ignored
+   * \param Filled with a pointer to the isotope in fullDataTable for each key, nullptr if it is not in the table.
+   *        Only the first results.size() keys are found if there are fewer results than keys.
+   *
+   * \return The number of keys that were found
+   */
+  std::size_t lookupMany(std::span<const NuclideKey> keys, std::span<const Isotope*> results) const;
+
+  /**
+   * Get a value of a single isotope, reading the reaction files first if they were deferred and are needed.
+   * The isotope is found with the chart index, so call buildIndex() if fullDataTable has been changed.
+   *
+   * \param The mass number of the isotope
+   * \param The proton number of the isotope
+   * \param The value to get
+   *
+   * \return[PASS] The value
+   * \return[FAIL] An empty optional if the isotope is not in the table, or the value was not read as it isn't in fields
+   */
+  [[nodiscard]] std::optional<Number> getQuantity(const uint16_t A, const uint16_t Z, const Quantity quantity) const;
+
+  /**
+   * Get all of the decay branches of a single isotope
+   *
+   * \param The mass number of the isotope
+   * \param The proton number of the isotope
+   *
+   * \return The branches, in the order they are given in the data file, empty if the isotope was not read
+   */
+  [[nodiscard]] std::span<const NUBASE::DecayBranch> getDecayBranches(const uint16_t A, const uint16_t Z) const;
+
   /**
    * Combine the data from NUBASE and AME into a single instance by looking for common A & Z values
    *
@@ -253,6 +483,39 @@ public:
    * \return Nothing
    */
   [[nodiscard]] bool outputTableToCSV() const;
+
+  /**
+   * Open the file that the isomeric states are written to, as requested by isomer_export
+   *
+   * \param The extension of the file when the states are written as text
+   * \param The first line of the file when the states are written as text, can be empty
+   *
+   * \return The opened file, which is not open if the states are not being written or the file could not be opened
+   */
+  [[nodiscard]] std::ofstream openIsomerFile(std::string_view extension, std::string_view header) const;
+
+  /**
+   * Close the file created by openIsomerFile(), once every state has been written
+   *
+   * \param The file
+   *
+   * \return[TRUE] Every state was written, or they are not being written
+   * \return[FALSE] The file could not be opened, or a write failed
+   */
+  [[nodiscard]] bool closeIsomerFile(std::ofstream& out) const;
+
+  /**
+   * Write the isomeric states of an isotope, as the main table is written
+   *
+   * \param The file created by openIsomerFile()
+   * \param The isotope, whose states are written in order of increasing level
+   * \param The function that converts a state into a line of text
+   *
+   * \return Nothing
+   */
+  void writeIsomers(std::ofstream& out,
+                    const Isotope& isotope,
+                    std::string (*as_text)(const NUBASE::IsomerState&)) const;
 };
 
 #endif // MASSTABLE_HPP
@@ -10,14 +10,20 @@
 #define NUBASEDATA_HPP
 
 #include "nuclear-data-reader/converter.hpp"
+#include "nuclear-data-reader/nubase_decay_mode.hpp"
+#include "nuclear-data-reader/nubase_isomer_table.hpp"
 #include "nuclear-data-reader/nubase_line_position.hpp"
+#include "nuclear-data-reader/nuclide_key.hpp"
 #include "nuclear-data-reader/number.hpp"
 #include <string_view>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -68,6 +74,52 @@ namespace NUBASE
     }();
   }
 
+  /**
+   * \class Symbol
+   *
+   * \brief An element symbol, which is never more than 2 characters, stored inline rather than on the heap
+   */
+  class Symbol
+  {
+  public:
+    constexpr Symbol() = default;
+
+    constexpr explicit Symbol(std::string_view symbol) noexcept
+    {
+      std::copy_n(symbol.cbegin(), std::min(symbol.size(), code.size()), code.begin());
+    }
+
+    constexpr Symbol(const Symbol&)     = default;
+    constexpr Symbol(Symbol&&) noexcept = default;
+
+    constexpr Symbol& operator=(const Symbol&)     = default;
+    constexpr Symbol& operator=(Symbol&&) noexcept = default;
+
+    constexpr ~Symbol() = default;
+
+    /// Unused characters are null
+    std::array<char, 2> code{};
+
+    /**
+     * Get the symbol as a string, only needed when writing the data
+     *
+     * \param Nothing
+     *
+     * \return The symbol
+     */
+    [[nodiscard]] constexpr std::string_view str() const noexcept
+    {
+      return { code.data(), static_cast<std::size_t>(std::count_if(code.cbegin(), code.cend(), [](const auto c) {
+                 return c != '\0';
+               })) };
+    }
+
+    constexpr bool operator==(const Symbol&) const noexcept = default;
+  };
+
+  /// What we use as the symbol if an invalid Z is read
+  static constexpr Symbol invalid_symbol{ "Xx" };
+
   class Data
   {
   public:
@@ -118,12 +170,12 @@ namespace NUBASE
     /// Error on the half life of the isotope
     mutable std::chrono::duration<double> hl_error{};
 
-    /// Human readable unit for half life
-    mutable std::string halflife_unit{};
+    /// Unit the half life is given in within the data file
+    mutable Converter::TimeUnit halflife_unit{ Converter::TimeUnit::UNKNOWN };
     /// Isotopic symbol
-    mutable std::string symbol{};
+    mutable Symbol symbol{};
     /// Decay mode of the isotope
-    mutable std::string decay{};
+    mutable DecayMode decay{};
     /// The entire line for the isotope from the data file
     mutable std::string full_data{};
 
@@ -131,26 +183,19 @@ namespace NUBASE
     /// (defined by which 'side' of stability it is on, not N=Z line)
     mutable Richness rich{ Richness::STABLE };
 
+    /// Position of the first excited state of the isotope in the IsomerTable it was linked to
+    mutable uint32_t isomer_offset{ 0 };
+    /// Number of excited states recorded for the isotope
+    mutable uint8_t isomer_count{ 0 };
+
     /**
-     * \struct State
+     * The key used to index and join the tables
+     *
+     * \param Nothing
      *
-     * \brief Details additional energy levels of the isotope
+     * \return The key of the state
      */
-    struct State
-    {
-      // They are easily swappable, but sometimes that's just the way it is.
-      // NOLINTNEXTLINE (bugprone-easily-swappable-parameters)
-      State(const uint8_t _level, const double _energy, const double _error) :
-          level(_level), energy(_energy), error(_error)
-      {
-      }
-
-      uint8_t level{ 0 };
-      double energy{ 0.0 };
-      double error{ 0.0 };
-    };
-    /// Container for all levels that are recorded in the data file that is read
-    mutable std::vector<State> energy_levels;
+    [[nodiscard]] inline NuclideKey key() const noexcept { return { A, Z, level }; }
 
     /**
      * Set the neutron number
@@ -242,8 +287,8 @@ namespace NUBASE
      */
     inline void setHalfLifeUnit() const
     {
-      halflife_unit = Converter::TrimStart(
-          full_data.substr(position.START_HALFLIFEUNIT, position.END_HALFLIFEUNIT - position.START_HALFLIFEUNIT), " ");
+      halflife_unit = Converter::ToTimeUnit(Converter::TrimStart(
+          fieldView(position.START_HALFLIFEUNIT, position.END_HALFLIFEUNIT - position.START_HALFLIFEUNIT), " "));
     }
 
 
@@ -256,13 +301,37 @@ namespace NUBASE
      */
     inline double getNumericalHalfLifeError() const
     {
-      auto hle =
-          full_data.substr(position.START_HALFLIFEERROR, (position.END_HALFLIFEERROR - position.START_HALFLIFEERROR));
-      std::replace(hle.begin(), hle.end(), '>', ' ');
-      std::replace(hle.begin(), hle.end(), '<', ' ');
+      // Treat limits as whitespace, we are only interested in the value
+      const auto hle = Converter::TrimString(
+          fieldView(position.START_HALFLIFEERROR, position.END_HALFLIFEERROR - position.START_HALFLIFEERROR), " <>");
       return Converter::StringToNum<double>(hle, 0, static_cast<uint8_t>(hle.size()));
     }
 
+    /**
+     * View part of the line from the data file, without the risk of an exception if the line is too short
+     *
+     * \param The first character position
+     * \param The number of characters
+     *
+     * \return The requested part of the line, clamped to the length of the line
+     */
+    [[nodiscard]] inline std::string_view fieldView(const std::size_t start, const std::size_t length) const noexcept
+    {
+      return (start > full_data.size()) ? std::string_view{} : std::string_view(full_data).substr(start, length);
+    }
+
+    /**
+     * View the full decay string, from the start of the decay column to the end of the line
+     *
+     * \param Nothing
+     *
+     * \return The decay string, empty if the line is too short to have one
+     */
+    [[nodiscard]] inline std::string_view decayString() const noexcept
+    {
+      return fieldView(position.START_DECAYSTRING, std::string_view::npos);
+    }
+
     /**
      * Set the isotope symbol
      *
@@ -270,7 +339,7 @@ namespace NUBASE
      *
      * \return Nothing
      */
-    inline void setSymbol(std::string_view _symbol) const noexcept { symbol = _symbol; }
+    inline void setSymbol(std::string_view _symbol) const noexcept { symbol = Symbol(_symbol); }
 
     /**
      * Modify the line from the data file swapping '#' for ' ' to maintain positioning.
@@ -344,13 +413,29 @@ namespace NUBASE
     }
 
     /**
-     * Convert obnoxiously singular spin parity values into ones that can be parsed with a relatively simple algorithm
+     * \struct SpinParity
+     *
+     * \brief The values that are read from the spin parity field of the data file
+     */
+    struct SpinParity
+    {
+      double J{ 100.0 };
+      Parity pi{ Parity::UNKNOWN };
+      Measured J_exp{ Measured::EXPERIMENTAL };
+      Measured pi_exp{ Measured::EXPERIMENTAL };
+    };
+
+    /**
+     * Parse the first spin parity value from the spin parity field in a single pass, without modifying the field.
+     * Handles integer and half integer spins, parity, tentative values in brackets, theoretical values marked with
+     * a #, lists and ranges. Where a field has more than one value, the first is used.
      *
-     * \param std::string The spin parity value from the file
+     * \param The spin parity field from the data file
      *
-     * \return
+     * \return[PASS] The first spin parity value in the field
+     * \return[FAIL] An empty optional if the field is a word or has neither a spin nor a parity
      */
-    [[nodiscard]] std::string cleanSpinParityString(std::string& spin_parity) const;
+    [[nodiscard]] static std::optional<SpinParity> parseSpinParity(std::string_view jpi) noexcept;
 
     /**
      * Extract the spin and parity from the data file
@@ -364,11 +449,13 @@ namespace NUBASE
     /**
      * Extract the isomeric data; level, energy and error on energy
      *
-     * \param The data read so far to allow us to populate the necessary state
+     * \param The data read so far, to find the ground state of this isomer
+     * \param The table to add the state to
      *
-     * \return Nothing
+     * \return[TRUE] The state was added
+     * \return[FALSE] There is no matching ground state in the data read so far
      */
-    void setIsomerData(std::vector<NUBASE::Data>& nuc) const;
+    [[nodiscard]] bool setIsomerData(std::vector<NUBASE::Data>& nuc, IsomerTable& isomers) const;
 
     /**
      * Extract the half life from the data file
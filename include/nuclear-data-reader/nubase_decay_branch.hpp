@@ -0,0 +1,145 @@
+/**
+ *
+ * \class DecayBranchTable
+ *
+ * \brief Every decay branch given in the NUBASE file, stored as one flat table
+ *
+ * The decay string of an isotope, e.g. B-=81 2;IT=19 2, is split into its branches. Branches of all isotopes are
+ * stored contiguously, in the order the isotopes are read, with the offset of the first branch of each isotope
+ * recorded separately (compressed sparse row layout). The branches of the isotope in row i are therefore
+ * branches[offsets[i]] to branches[offsets[i + 1]].
+ */
+#ifndef NUBASE_DECAY_BRANCH_HPP
+#define NUBASE_DECAY_BRANCH_HPP
+
+#include "nuclear-data-reader/nubase_decay_mode.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include <string_view>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace NUBASE
+{
+  /// How the branching ratio is qualified in the data file
+  enum class Qualifier : uint8_t
+  {
+    /// =
+    EQUAL            = 0,
+    /// ~
+    APPROXIMATE      = 1,
+    /// <
+    LESS             = 2,
+    /// =< or LE
+    LESS_OR_EQUAL    = 3,
+    /// >
+    GREATER          = 4,
+    /// => or GE
+    GREATER_OR_EQUAL = 5,
+    /// ? or =?, the branch is expected but has not been observed
+    UNKNOWN          = 6,
+    /// No ratio was given
+    NONE             = 7
+  };
+
+  /**
+   * \struct DecayBranch
+   *
+   * \brief A single decay mode of an isotope
+   */
+  struct DecayBranch
+  {
+    DecayMode mode{};
+    Qualifier qualifier{ Qualifier::NONE };
+    /// The branching ratio, or isotopic abundance for stable isotopes, in %.
+    /// Stored as the max value of a double if there is no ratio.
+    Number ratio{};
+  };
+
+  class DecayBranchTable
+  {
+  public:
+    DecayBranchTable() = default;
+
+    DecayBranchTable(const DecayBranchTable&)     = default;
+    DecayBranchTable(DecayBranchTable&&) noexcept = default;
+
+    DecayBranchTable& operator=(const DecayBranchTable&)     = default;
+    DecayBranchTable& operator=(DecayBranchTable&&) noexcept = default;
+
+    ~DecayBranchTable() = default;
+
+    /// Branches of all isotopes, grouped by isotope
+    std::vector<DecayBranch> branches;
+    /// Position of the first branch of each isotope, with a final entry of branches.size()
+    std::vector<uint32_t> offsets{ 0 };
+
+    /**
+     * Remove all isotopes and their branches
+     *
+     * \param Nothing
+     *
+     * \return Nothing
+     */
+    inline void clear()
+    {
+      branches.clear();
+      offsets.assign(1, 0);
+    }
+
+    /**
+     * The number of isotopes (rows) in the table
+     *
+     * \param Nothing
+     *
+     * \return The number of isotopes
+     */
+    [[nodiscard]] inline std::size_t size() const noexcept { return offsets.size() - 1; }
+
+    /**
+     * Parse the decay string of an isotope and add its branches as the next row of the table
+     *
+     * \param The decay string, from the start of the decay column to the end of the line
+     *
+     * \return The number of branches that were added
+     */
+    std::size_t addIsotope(std::string_view decay_string);
+
+    /**
+     * Add an isotope with no branches, keeping the rows aligned with the isotopes that were read
+     *
+     * \param Nothing
+     *
+     * \return Nothing
+     */
+    inline void addEmptyIsotope() { offsets.push_back(offsets.back()); }
+
+    /**
+     * Get the branches of the isotope in the given row
+     *
+     * \param The row of the isotope
+     *
+     * \return The branches of that isotope, empty if the row does not exist
+     */
+    [[nodiscard]] std::span<const DecayBranch> branchesOf(const std::size_t row) const noexcept
+    {
+      return (row >= size()) ? std::span<const DecayBranch>{}
+                             : std::span<const DecayBranch>(branches).subspan(offsets[row],
+                                                                              offsets[row + 1] - offsets[row]);
+    }
+
+    /**
+     * Parse a single branch of a decay string, e.g. B-n=0.58 12
+     *
+     * \param The branch
+     *
+     * \return The parsed branch, with an empty mode if the string does not contain one
+     */
+    [[nodiscard]] static DecayBranch parseBranch(std::string_view branch);
+  };
+} // namespace NUBASE
+
+#endif // NUBASE_DECAY_BRANCH_HPP
@@ -0,0 +1,125 @@
+/**
+ *
+ * \class DecayMode
+ *
+ * \brief An interned decay mode string
+ *
+ * There are only a handful of distinct decay modes in a NUBASE file, so rather than store a string for every
+ * isotope, store an id into a table of the modes that have been seen. The common modes are known at compile time so
+ * always have the same id, anything else is added to a process wide, thread safe, table the first time it is seen.
+ * Comparing two modes is an integer comparison, the string is only needed when the data is written out.
+ */
+#ifndef NUBASE_DECAY_MODE_HPP
+#define NUBASE_DECAY_MODE_HPP
+
+#include <string_view>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+
+namespace NUBASE
+{
+  class DecayMode
+  {
+  public:
+    constexpr DecayMode() = default;
+
+    explicit DecayMode(std::string_view mode) : id(intern(mode)) {}
+
+    constexpr DecayMode(const DecayMode&)     = default;
+    constexpr DecayMode(DecayMode&&) noexcept = default;
+
+    constexpr DecayMode& operator=(const DecayMode&)     = default;
+    constexpr DecayMode& operator=(DecayMode&&) noexcept = default;
+
+    constexpr ~DecayMode() = default;
+
+    /// The modes that are registered at compile time, the position in the array is the id. The empty string must be
+    /// first so a default constructed mode is empty.
+    static constexpr std::array<std::string_view, 18> common_modes{ "",   "stable", "unknown", "isomer?", "B-", "B+",
+                                                                     "A",  "EC",     "IT",      "SF",      "p",  "n",
+                                                                     "2p", "2n",     "3p",      "B-n",     "2B-", "-" };
+
+    /**
+     * Get one of the modes that are registered at compile time, without touching the process wide table
+     *
+     * \param The decay mode, which must be one of common_modes
+     *
+     * \return The DecayMode
+     */
+    [[nodiscard]] static consteval DecayMode common(std::string_view mode)
+    {
+      const auto found = std::find(common_modes.cbegin(), common_modes.cend(), mode);
+      // Not a constant expression so compilation will fail if the mode is not in the list
+      if (found == common_modes.cend())
+        {
+          throw "Decay mode is not registered at compile time";
+        }
+
+      DecayMode decay;
+      decay.id = static_cast<uint16_t>(std::distance(common_modes.cbegin(), found));
+      return decay;
+    }
+
+    /**
+     * Some modes are written in more than one way, or are not really decay modes, convert them to the name we use
+     *
+     * \param The decay mode as it is written in the data file
+     *
+     * \return The name we use for the mode
+     */
+    [[nodiscard]] static constexpr std::string_view canonical(const std::string_view mode) noexcept
+    {
+      // swap e+ for B+
+      if (mode == "e+")
+        {
+          return "B+";
+        }
+      // use "stable" instead of "IS"
+      if (mode == "IS")
+        {
+          return "stable";
+        }
+      return mode;
+    }
+
+    /**
+     * Get the decay mode as a string, only needed when writing the data
+     *
+     * \param Nothing
+     *
+     * \return The decay mode, which remains valid for the life of the program
+     */
+    [[nodiscard]] std::string_view str() const;
+
+    /**
+     * Get the id of the decay mode, unique to the mode for the life of the program
+     *
+     * \param Nothing
+     *
+     * \return The id
+     */
+    [[nodiscard]] constexpr uint16_t value() const noexcept { return id; }
+
+    constexpr bool operator==(const DecayMode&) const noexcept = default;
+
+  private:
+    /// Position in common_modes, or common_modes.size() + the position in the process wide table
+    uint16_t id{ 0 };
+
+    /**
+     * Find the id of a decay mode, adding it to the process wide table if it has not been seen before
+     *
+     * \param The decay mode
+     *
+     * \return The id of the mode
+     */
+    [[nodiscard]] static uint16_t intern(std::string_view mode);
+  };
+} // namespace NUBASE
+
+#endif // NUBASE_DECAY_MODE_HPP
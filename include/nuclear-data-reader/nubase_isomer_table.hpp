@@ -0,0 +1,161 @@
+/**
+ *
+ * \class IsomerTable
+ *
+ * \brief Every isomeric state given in the NUBASE file, stored as one flat table
+ *
+ * Rather than each ground state owning a container of its excited states, all states are stored contiguously, sorted
+ * by (A, Z, level). A ground state only records where its states start in the table and how many there are, so
+ * copying an isotope does not copy its states and walking the states of the whole chart is a single linear sweep.
+ */
+#ifndef NUBASE_ISOMER_TABLE_HPP
+#define NUBASE_ISOMER_TABLE_HPP
+
+#include "nuclear-data-reader/nuclide_key.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace NUBASE
+{
+  class Data;
+
+  /**
+   * \struct IsomerState
+   *
+   * \brief Details an additional energy level of an isotope
+   */
+  struct IsomerState
+  {
+    uint16_t A{ 0 };
+    uint16_t Z{ 0 };
+    uint8_t level{ 0 };
+    double energy{ 0.0 };
+    double error{ 0.0 };
+
+    /// The key of the state, the states of an isotope share the key of its ground state apart from the level
+    [[nodiscard]] constexpr NuclideKey key() const noexcept { return { A, Z, level }; }
+  };
+
+  class IsomerTable
+  {
+  public:
+    IsomerTable() = default;
+
+    IsomerTable(const IsomerTable&)     = default;
+    IsomerTable(IsomerTable&&) noexcept = default;
+
+    IsomerTable& operator=(const IsomerTable&)     = default;
+    IsomerTable& operator=(IsomerTable&&) noexcept = default;
+
+    ~IsomerTable() = default;
+
+    /// All states of all isotopes, sorted by (A, Z, level) once link() has been called
+    std::vector<IsomerState> states;
+
+    /**
+     * Remove all of the states
+     *
+     * \param Nothing
+     *
+     * \return Nothing
+     */
+    inline void clear() { states.clear(); }
+
+    /**
+     * The number of states, across all isotopes, in the table
+     *
+     * \param Nothing
+     *
+     * \return The number of states
+     */
+    [[nodiscard]] inline std::size_t size() const noexcept { return states.size(); }
+
+    /**
+     * Add a state to the table, it will not be visible from its ground state until link() is called
+     *
+     * \param The state
+     *
+     * \return Nothing
+     */
+    inline void add(const IsomerState& state) { states.push_back(state); }
+
+    /**
+     * Sort the table and record in each ground state the position and number of its states
+     *
+     * \param All of the ground states that have been read
+     *
+     * \return Nothing
+     */
+    void link(std::span<const Data> ground_states);
+
+    /**
+     * Get the states of a ground state
+     *
+     * \param The ground state, that has been passed to link()
+     *
+     * \return The states of the isotope, in order of increasing level
+     */
+    [[nodiscard]] std::span<const IsomerState> statesOf(const Data& ground_state) const noexcept;
+
+    /// Decimal precision used when the states are written as text, matching Isotope::NDP
+    static constexpr uint8_t NDP{ 4 };
+
+    /// Size, in bytes, of a single state when written as binary
+    static constexpr std::size_t BINARY_RECORD_SIZE{ 24 };
+
+    /**
+     * Create the header line to be used when writing as a csv
+     *
+     * \param Nothing
+     *
+     * \return The variable names in csv formatted string
+     */
+    [[nodiscard]] static std::string writeCSVHeader() { return std::string("A,Z,Level,Energy,ErrorEnergy"); }
+
+    /**
+     * Output a single state as a csv string
+     *
+     * \param The state
+     *
+     * \return The state in csv format
+     */
+    [[nodiscard]] static std::string writeAsCSV(const IsomerState& state);
+
+    /**
+     * Output a single state as a json object on a single line, so the states can be written as newline delimited json
+     *
+     * \param The state
+     *
+     * \return The state in the format of a json unit
+     */
+    [[nodiscard]] static std::string writeAsJSON(const IsomerState& state);
+
+    /**
+     * Create the header that starts a binary file of states.
+     * 8 byte magic string, followed by the size of a record as a 4 byte integer and 4 bytes that are reserved.
+     *
+     * \param Nothing
+     *
+     * \return The header
+     */
+    [[nodiscard]] static std::array<char, 16> writeBinaryHeader() noexcept;
+
+    /**
+     * Output a single state as a fixed size record, in the native byte order
+     *  [0, 2) A, [2, 4) Z, [4, 5) level, [5, 8) zero, [8, 16) energy, [16, 24) error on energy
+     *
+     * \param The state
+     *
+     * \return The state as a binary record
+     */
+    [[nodiscard]] static std::array<char, BINARY_RECORD_SIZE> writeAsBinary(const IsomerState& state) noexcept;
+  };
+} // namespace NUBASE
+
+#endif // NUBASE_ISOMER_TABLE_HPP
@@ -0,0 +1,136 @@
+/**
+ *
+ * \class NuclideKey
+ *
+ * \brief Identify an isotope, or one of its excited states, with a single 32 bit integer
+ *
+ * A, Z and the level of the state are packed into one value, A in the highest bits and the level in the lowest. Keys
+ * therefore order by (A, Z, level), the order of the data files, and the packed value orders the same way so a list of
+ * keys can be radix sorted on its bits. They are cheap to copy, compare and hash, so are used to index and join the
+ * tables, and can be used as the key of a std::map or std::unordered_map.
+ */
+#ifndef NUCLIDE_KEY_HPP
+#define NUCLIDE_KEY_HPP
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+
+class NuclideKey
+{
+public:
+  constexpr NuclideKey() = default;
+
+  /**
+   * Create the key of an isotope, or an excited state of it
+   *
+   * \param The mass number
+   * \param The proton number
+   * \param The level of the state, 0 for the ground state
+   */
+  constexpr NuclideKey(const uint16_t A, const uint16_t Z, const uint8_t level = 0) noexcept :
+      bits(((A & FIELD_MAX) << A_SHIFT) | ((Z & FIELD_MAX) << Z_SHIFT) | level)
+  {
+  }
+
+  constexpr NuclideKey(const NuclideKey&)     = default;
+  constexpr NuclideKey(NuclideKey&&) noexcept = default;
+
+  constexpr NuclideKey& operator=(const NuclideKey&)     = default;
+  constexpr NuclideKey& operator=(NuclideKey&&) noexcept = default;
+
+  ~NuclideKey() = default;
+
+  /// Largest value that A or Z can have
+  static constexpr uint32_t FIELD_MAX{ 0xFFF };
+  /// Where each value starts within the key
+  static constexpr uint32_t A_SHIFT{ 20 };
+  static constexpr uint32_t Z_SHIFT{ 8 };
+
+  /// The packed value, A in bits 20-31, Z in bits 8-19 and the level in bits 0-7
+  uint32_t bits{ 0 };
+
+  /**
+   * Create the key of an isotope from its position on the chart
+   *
+   * \param The proton number
+   * \param The neutron number
+   * \param The level of the state, 0 for the ground state
+   *
+   * \return The key
+   */
+  [[nodiscard]] static constexpr NuclideKey fromZN(const uint16_t Z, const uint16_t N, const uint8_t level = 0) noexcept
+  {
+    return { static_cast<uint16_t>(Z + N), Z, level };
+  }
+
+  /// Keys are equal if all of A, Z and level are, and are ordered by A, then Z, then level
+  friend constexpr auto operator<=>(const NuclideKey&, const NuclideKey&) noexcept = default;
+
+  /**
+   * The mass number
+   *
+   * \param Nothing
+   *
+   * \return A
+   */
+  [[nodiscard]] constexpr inline uint16_t A() const noexcept { return static_cast<uint16_t>(bits >> A_SHIFT); }
+
+  /**
+   * The proton number
+   *
+   * \param Nothing
+   *
+   * \return Z
+   */
+  [[nodiscard]] constexpr inline uint16_t Z() const noexcept
+  {
+    return static_cast<uint16_t>((bits >> Z_SHIFT) & FIELD_MAX);
+  }
+
+  /**
+   * The neutron number. If A < Z the value wraps, so is larger than any real isotope and will never be found.
+   *
+   * \param Nothing
+   *
+   * \return N
+   */
+  [[nodiscard]] constexpr inline uint16_t N() const noexcept { return static_cast<uint16_t>(A() - Z()); }
+
+  /**
+   * The level of the state
+   *
+   * \param Nothing
+   *
+   * \return The level, 0 for the ground state
+   */
+  [[nodiscard]] constexpr inline uint8_t level() const noexcept { return static_cast<uint8_t>(bits & 0xFF); }
+
+  /**
+   * The key of the ground state of the same isotope
+   *
+   * \param Nothing
+   *
+   * \return The key with the level set to 0
+   */
+  [[nodiscard]] constexpr inline NuclideKey groundState() const noexcept { return { A(), Z() }; }
+};
+
+
+/**
+ * Hash a key by multiplying by 2^64 divided by the golden ratio and keeping the upper half, so keys of neighbouring
+ * isotopes, which only differ in a few bits, are spread over all of the buckets.
+ */
+template<>
+struct std::hash<NuclideKey>
+{
+  [[nodiscard]] std::size_t operator()(const NuclideKey key) const noexcept
+  {
+    const uint64_t mixed = uint64_t{ key.bits } * 0x9E3779B97F4A7C15ULL;
+    return mixed >> 32U;
+  }
+};
+
+#endif // NUCLIDE_KEY_HPP
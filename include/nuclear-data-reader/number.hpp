@@ -10,6 +10,7 @@
 #define NUMBER_HPP
 
 #include <cmath>
+#include <limits>
 #include <optional>
 
 class Number
@@ -31,12 +32,25 @@ public:
 
   ~Number() = default;
 
+  /// Stored in place of a value that is not known, either because it isn't in the file or because it wasn't read
+  static constexpr double MISSING{ std::numeric_limits<double>::max() };
+
+  /**
+   * Is the value the one that is stored when it is not known
+   *
+   * \param The value to check
+   *
+   * \return[TRUE] The value is not known
+   * \return[FALSE] The value is known
+   */
+  [[nodiscard]] static constexpr bool isMissing(const double value) noexcept { return !(value < MISSING); }
+
 
   // What is the recorded amount of the number
   // 'amount' is not a good name, but 'value' is already taken by std::optional
-  mutable double amount{};
+  double amount{};
   // Is there an uncertainty associated with the number
-  mutable std::optional<double> uncertainty{};
+  std::optional<double> uncertainty{};
 
   /**
    * Calculate the relative uncertainty on the number if there is an uncertainty.
@@ -0,0 +1,133 @@
+/**
+ *
+ * \enum Quantity
+ *
+ * \brief The numerical values that are stored for each isotope
+ *
+ * Allow the values stored in an Isotope to be selected at runtime, e.g. when comparing tables from different years
+ */
+#ifndef QUANTITY_HPP
+#define QUANTITY_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+
+enum class Quantity : uint8_t
+{
+  AME_MASS_EXCESS      = 0,
+  NUBASE_MASS_EXCESS   = 1,
+  BINDING_ENERGY_PER_A = 2,
+  BETA_DECAY_ENERGY    = 3,
+  ATOMIC_MASS          = 4,
+  S_N                  = 5,
+  S_P                  = 6,
+  S_2N                 = 7,
+  S_2P                 = 8,
+  Q_ALPHA              = 9,
+  Q_2BM                = 10,
+  Q_EP                 = 11,
+  Q_BM_N               = 12,
+  Q_4BM                = 13,
+  Q_DA                 = 14,
+  Q_PA                 = 15,
+  Q_NA                 = 16,
+  HALF_LIFE            = 17
+};
+
+/// Every numerical quantity, in the order they are declared
+static constexpr std::array<Quantity, 18> all_quantities{ Quantity::AME_MASS_EXCESS,
+                                                          Quantity::NUBASE_MASS_EXCESS,
+                                                          Quantity::BINDING_ENERGY_PER_A,
+                                                          Quantity::BETA_DECAY_ENERGY,
+                                                          Quantity::ATOMIC_MASS,
+                                                          Quantity::S_N,
+                                                          Quantity::S_P,
+                                                          Quantity::S_2N,
+                                                          Quantity::S_2P,
+                                                          Quantity::Q_ALPHA,
+                                                          Quantity::Q_2BM,
+                                                          Quantity::Q_EP,
+                                                          Quantity::Q_BM_N,
+                                                          Quantity::Q_4BM,
+                                                          Quantity::Q_DA,
+                                                          Quantity::Q_PA,
+                                                          Quantity::Q_NA,
+                                                          Quantity::HALF_LIFE };
+
+/// The quantities that are read from the first AME reaction file (rct1)
+static constexpr std::array<Quantity, 6> reaction_1_quantities{ Quantity::S_2N,  Quantity::S_2P, Quantity::Q_ALPHA,
+                                                                Quantity::Q_2BM, Quantity::Q_EP, Quantity::Q_BM_N };
+
+/// The quantities that are read from the second AME reaction file (rct2)
+static constexpr std::array<Quantity, 6> reaction_2_quantities{ Quantity::S_N,  Quantity::S_P,  Quantity::Q_4BM,
+                                                                Quantity::Q_DA, Quantity::Q_PA, Quantity::Q_NA };
+
+/**
+ * Is the quantity read from one of the AME reaction files (rct1 or rct2)
+ *
+ * \param The quantity
+ *
+ * \return[TRUE] The value comes from a reaction file
+ * \return[FALSE] The value comes from the AME mass file or NUBASE
+ */
+[[nodiscard]] static constexpr inline bool isReactionQuantity(const Quantity value) noexcept
+{
+  return value >= Quantity::S_N && value <= Quantity::Q_NA;
+}
+
+/**
+ * Get the name of the quantity, matching the column headers used when writing csv or json files
+ *
+ * \param The quantity
+ *
+ * \return The name as a std::string
+ */
+static inline std::string printQuantity(const Quantity value)
+{
+  return [=]() -> std::string {
+    switch (value)
+      {
+        case Quantity::AME_MASS_EXCESS:
+          return "AMEMassExcess";
+        case Quantity::NUBASE_MASS_EXCESS:
+          return "NubaseMassExcess";
+        case Quantity::BINDING_ENERGY_PER_A:
+          return "BindingEnergyPerA";
+        case Quantity::BETA_DECAY_ENERGY:
+          return "BetaDecayEnergy";
+        case Quantity::ATOMIC_MASS:
+          return "AtomicMass";
+        case Quantity::S_N:
+          return "SingleNeutronSeparationEnergy";
+        case Quantity::S_P:
+          return "SingleProtonSeparationEnergy";
+        case Quantity::S_2N:
+          return "DoubleNeutronSeparationEnergy";
+        case Quantity::S_2P:
+          return "DoubleProtonSeparationEnergy";
+        case Quantity::Q_ALPHA:
+          return "QAlpha";
+        case Quantity::Q_2BM:
+          return "Q2B-";
+        case Quantity::Q_EP:
+          return "Qepsilon_p";
+        case Quantity::Q_BM_N:
+          return "QB-n";
+        case Quantity::Q_4BM:
+          return "Q4B-";
+        case Quantity::Q_DA:
+          return "QdAlpha";
+        case Quantity::Q_PA:
+          return "QpAlpha";
+        case Quantity::Q_NA:
+          return "QnAlpha";
+        case Quantity::HALF_LIFE:
+        default:
+          return "HalfLife";
+      }
+  }();
+}
+
+#endif // QUANTITY_HPP
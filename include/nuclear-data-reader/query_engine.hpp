@@ -0,0 +1,132 @@
+/**
+ *
+ * \class QueryEngine
+ *
+ * \brief Answer binary requests, as described in query_protocol.hpp, from tables held in memory
+ *
+ * The table of each year is held by a TableHandle, so can be reloaded without stopping the requests being answered.
+ * The engine only deals in bytes, the transport is up to the caller. ndr-serve uses it behind a Unix domain socket.
+ */
+#ifndef QUERY_ENGINE_HPP
+#define QUERY_ENGINE_HPP
+
+#include "nuclear-data-reader/query_protocol.hpp"
+#include "nuclear-data-reader/table_handle.hpp"
+#include "nuclear-data-reader/table_snapshot.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+class QueryEngine
+{
+public:
+  /**
+   * Nothing is loaded until load() is called
+   *
+   * \param The years to serve, any that are not valid are ignored
+   */
+  explicit QueryEngine(std::span<const uint16_t> years);
+
+  QueryEngine(const QueryEngine&) = delete;
+  QueryEngine(QueryEngine&&)      = delete;
+
+  QueryEngine& operator=(const QueryEngine&) = delete;
+  QueryEngine& operator=(QueryEngine&&)      = delete;
+
+  ~QueryEngine() = default;
+
+  /**
+   * The years being served, 1997 is served as 1995 (see MassTable)
+   *
+   * \param Nothing
+   *
+   * \return The years, in the order they were given
+   */
+  [[nodiscard]] std::vector<uint16_t> years() const;
+
+  /**
+   * Populate the table of every year
+   *
+   * \param Nothing
+   *
+   * \return[TRUE] Every table has been loaded
+   * \return[FALSE] At least one table could not be loaded
+   */
+  [[nodiscard]] bool load();
+
+  /**
+   * Reload the table of every year, each on a separate thread, while requests continue to be answered
+   *
+   * \param Nothing
+   *
+   * \return Nothing
+   */
+  void reloadInBackground();
+
+  /**
+   * Answer every complete request at the start of the input. A partial request is left for the next call, once the
+   * rest of it has arrived. Stop early once the output has reached the limit, so a client that does not read its
+   * responses can be made to wait, the remaining requests are left for a later call.
+   *
+   * \param The bytes received
+   * \param Where the responses are added
+   * \param Stop answering requests once the output is at least this size
+   *
+   * \return[PASS] The number of bytes of the input that have been used
+   * \return[FAIL] An empty optional if the input can not be a request, the connection should be closed
+   */
+  [[nodiscard]] std::optional<std::size_t>
+  process(std::span<const std::byte> input,
+          std::vector<std::byte>& output,
+          const std::size_t output_limit = std::numeric_limits<std::size_t>::max()) const;
+
+private:
+  /// The table of each year being served
+  std::vector<std::unique_ptr<TableHandle>> tables;
+
+  /**
+   * Find the table of a year
+   *
+   * \param The year
+   *
+   * \return The handle of the table, nullptr if the year is not served
+   */
+  [[nodiscard]] const TableHandle* find(const uint16_t year) const noexcept;
+
+  /**
+   * Answer a single request
+   *
+   * \param The header of the request
+   * \param The entries of the request
+   * \param Where the response is added
+   *
+   * \return Nothing
+   */
+  void answer(const Query::RequestHeader& header, std::span<const std::byte> payload, std::vector<std::byte>& output)
+      const;
+
+  /**
+   * Add a row of the response
+   *
+   * \param The table being queried
+   * \param The row of the table, or nothing if the isotope is not in the table
+   * \param The A and Z that were asked for
+   * \param The quantities to add
+   * \param Where the row is added
+   *
+   * \return Nothing
+   */
+  static void appendRow(const TableSnapshot& snapshot,
+                        const std::optional<std::size_t> row,
+                        const Query::Nuclide nuclide,
+                        const uint32_t quantities,
+                        std::vector<std::byte>& output);
+};
+
+#endif // QUERY_ENGINE_HPP
@@ -0,0 +1,245 @@
+/**
+ *
+ * \namespace Query
+ *
+ * \brief The binary format of the requests answered by a QueryEngine, and so by ndr-serve
+ *
+ * Every message is a fixed size header followed by a payload of fixed size entries. Values are in the byte order of
+ * the host, as messages are only passed over a local socket. A client can send any number of requests without waiting
+ * for the responses, which are sent back in the order the requests were received. Each response repeats the tag of
+ * its request so they can be matched up.
+ *
+ * Requests
+ *  - LOOKUP: The payload is `count` Nuclide entries. There is one row in the response for each, in the same order,
+ *    whether or not the isotope is in the table.
+ *  - REGION: The payload is `count` Region entries. The response has a row for every isotope in each region, regions
+ *    in the order they were given and isotopes ordered by Z then N.
+ *
+ * The `quantities` of a request is a bitmask, bit i selects the Quantity with value i. Each row of the response is a
+ * RowHeader followed by a Value for each selected quantity, in the order of Quantity. The rows of a single response
+ * can take up at most MAX_RESPONSE_SIZE bytes, split a request that needs more.
+ */
+#ifndef QUERY_PROTOCOL_HPP
+#define QUERY_PROTOCOL_HPP
+
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+
+namespace Query
+{
+  /// What is being asked for
+  enum class Operation : uint8_t
+  {
+    /// Individual isotopes given by (A, Z)
+    LOOKUP = 0,
+    /// Every isotope within rectangular regions of the chart
+    REGION = 1
+  };
+
+  /// Was the request answered
+  enum class Status : uint8_t
+  {
+    /// The request was answered, the payload holds the rows
+    OK = 0,
+    /// The year is not one of those being served
+    UNKNOWN_YEAR = 1,
+    /// The year is served, but its table has not been loaded
+    NOT_LOADED = 2,
+    /// The operation, quantities or size of the payload are not valid, or the response would be larger than
+    /// MAX_RESPONSE_SIZE. There are no rows.
+    BAD_REQUEST = 3
+  };
+
+  /**
+   * \struct RequestHeader
+   *
+   * \brief The start of every request
+   */
+  struct RequestHeader
+  {
+    /// Size, in bytes, of the entries that follow the header
+    uint32_t payload_size{ 0 };
+    /// Chosen by the client and repeated in the response
+    uint32_t tag{ 0 };
+    Operation operation{ Operation::LOOKUP };
+    uint8_t reserved{ 0 };
+    /// The year of the table to query
+    uint16_t year{ 0 };
+    /// Bitmask of the quantities to return
+    uint32_t quantities{ 0 };
+    /// Number of entries in the payload
+    uint32_t count{ 0 };
+  };
+
+  /**
+   * \struct ResponseHeader
+   *
+   * \brief The start of every response
+   */
+  struct ResponseHeader
+  {
+    /// Size, in bytes, of the rows that follow the header
+    uint32_t payload_size{ 0 };
+    /// The tag of the request
+    uint32_t tag{ 0 };
+    Status status{ Status::OK };
+    uint8_t reserved{ 0 };
+    /// The year of the request
+    uint16_t year{ 0 };
+    /// The quantities of the request, so the size of a row is known
+    uint32_t quantities{ 0 };
+    /// Number of rows in the payload
+    uint32_t count{ 0 };
+  };
+
+  /// An entry of a LOOKUP request
+  struct Nuclide
+  {
+    uint16_t A{ 0 };
+    uint16_t Z{ 0 };
+  };
+
+  /// An entry of a REGION request, boundaries are inclusive
+  struct Region
+  {
+    uint16_t Zmin{ 0 };
+    uint16_t Zmax{ 0 };
+    uint16_t Nmin{ 0 };
+    uint16_t Nmax{ 0 };
+  };
+
+  /// The start of every row of a response
+  struct RowHeader
+  {
+    uint16_t A{ 0 };
+    uint16_t Z{ 0 };
+    uint16_t N{ 0 };
+    /// FOUND if the isotope is in the table, the values are NaN if not
+    uint16_t flags{ 0 };
+  };
+
+  /// A single quantity of a row, the uncertainty is NaN if there isn't one
+  struct Value
+  {
+    double amount{ 0.0 };
+    double uncertainty{ 0.0 };
+  };
+
+  static_assert(sizeof(RequestHeader) == 20 && std::is_trivially_copyable_v<RequestHeader>);
+  static_assert(sizeof(ResponseHeader) == 20 && std::is_trivially_copyable_v<ResponseHeader>);
+  static_assert(sizeof(Nuclide) == 4 && sizeof(Region) == 8 && sizeof(RowHeader) == 8 && sizeof(Value) == 16);
+
+  /// Set in RowHeader::flags if the isotope is in the table
+  static constexpr uint16_t FOUND{ 1 };
+
+  /// Every quantity that can be selected
+  static constexpr uint32_t ALL_QUANTITIES{ (1U << all_quantities.size()) - 1 };
+
+  /// A request with a larger payload can not be answered and the connection is closed
+  static constexpr uint32_t MAX_PAYLOAD_SIZE{ 1U << 24 };
+  /// A request whose rows would take up more than this is answered with BAD_REQUEST
+  static constexpr uint32_t MAX_RESPONSE_SIZE{ 1U << 26 };
+
+  /**
+   * Select a single quantity
+   *
+   * \param The quantity
+   *
+   * \return The bitmask of the quantity
+   */
+  [[nodiscard]] static constexpr inline uint32_t select(const Quantity quantity) noexcept
+  {
+    return 1U << static_cast<uint32_t>(quantity);
+  }
+
+  /**
+   * The size of each row of a response
+   *
+   * \param The quantities of the request
+   *
+   * \return The size, in bytes
+   */
+  [[nodiscard]] static constexpr inline std::size_t rowSize(const uint32_t quantities) noexcept
+  {
+    return sizeof(RowHeader) + static_cast<std::size_t>(std::popcount(quantities)) * sizeof(Value);
+  }
+
+  /**
+   * Copy a value out of a buffer, which need not be aligned
+   *
+   * \param The buffer
+   * \param Where, in bytes, the value starts
+   *
+   * \return The value
+   */
+  template<typename T>
+  [[nodiscard]] inline T read(std::span<const std::byte> buffer, const std::size_t offset) noexcept
+  {
+    T value{};
+    std::memcpy(&value, buffer.data() + offset, sizeof(T));
+    return value;
+  }
+
+  /**
+   * Copy a value onto the end of a buffer
+   *
+   * \param The buffer
+   * \param The value
+   *
+   * \return Nothing
+   */
+  template<typename T>
+  inline void append(std::vector<std::byte>& buffer, const T& value)
+  {
+    const auto offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+  }
+
+  /**
+   * Add a complete request to the end of a buffer
+   *
+   * \param The buffer
+   * \param Chosen by the client and repeated in the response
+   * \param The year of the table to query
+   * \param Bitmask of the quantities to return
+   * \param Nuclide entries for a LOOKUP, or Region entries for a REGION request
+   *
+   * \return Nothing
+   */
+  template<typename Entry>
+  inline void appendRequest(std::vector<std::byte>& buffer,
+                            const uint32_t tag,
+                            const uint16_t year,
+                            const uint32_t quantities,
+                            std::span<const Entry> entries)
+  {
+    static_assert(std::is_same_v<Entry, Nuclide> || std::is_same_v<Entry, Region>);
+
+    RequestHeader header;
+    header.payload_size = static_cast<uint32_t>(entries.size_bytes());
+    header.tag          = tag;
+    header.operation    = std::is_same_v<Entry, Nuclide> ? Operation::LOOKUP : Operation::REGION;
+    header.year         = year;
+    header.quantities   = quantities;
+    header.count        = static_cast<uint32_t>(entries.size());
+
+    append(buffer, header);
+    if (!entries.empty())
+      {
+        const auto offset = buffer.size();
+        buffer.resize(offset + entries.size_bytes());
+        std::memcpy(buffer.data() + offset, entries.data(), entries.size_bytes());
+      }
+  }
+} // namespace Query
+
+#endif // QUERY_PROTOCOL_HPP
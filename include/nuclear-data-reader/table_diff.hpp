@@ -0,0 +1,129 @@
+/**
+ *
+ * \class TableDiff
+ *
+ * \brief Compare the values of two populated mass tables
+ *
+ * Align the isotopes of two tables, normally from different years, on A and Z. Record which isotopes have been
+ * added or removed, and by how much the requested values of those in both tables have changed.
+ */
+#ifndef TABLEDIFF_HPP
+#define TABLEDIFF_HPP
+
+#include "nuclear-data-reader/diagnostics.hpp"
+#include "nuclear-data-reader/isotope.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/nuclide_key.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+class TableDiff
+{
+public:
+  explicit TableDiff(std::vector<Quantity> _quantities = { all_quantities.cbegin(), all_quantities.cend() }) :
+      quantities(std::move(_quantities))
+  {
+  }
+
+  TableDiff(const TableDiff&)     = default;
+  TableDiff(TableDiff&&) noexcept = default;
+
+  TableDiff& operator=(const TableDiff&)     = default;
+  TableDiff& operator=(TableDiff&&) noexcept = default;
+
+  ~TableDiff() = default;
+
+  /**
+   * \struct Nuclide
+   *
+   * \brief The minimum needed to identify an isotope that is only in one of the tables
+   */
+  struct Nuclide
+  {
+    uint16_t A{ 0 };
+    uint16_t Z{ 0 };
+  };
+
+  /**
+   * \struct Change
+   *
+   * \brief A single value of an isotope that is different in the two tables
+   */
+  struct Change
+  {
+    uint16_t A{ 0 };
+    uint16_t Z{ 0 };
+    Quantity quantity{ Quantity::AME_MASS_EXCESS };
+    double before{ 0.0 };
+    double after{ 0.0 };
+    /// after - before
+    double delta{ 0.0 };
+    /// delta divided by the uncertainties added in quadrature, infinite if neither value has an uncertainty
+    double significance{ 0.0 };
+  };
+
+  /// The values that will be compared
+  std::vector<Quantity> quantities;
+  /// Changes with a magnitude that is not larger than this are ignored
+  double threshold{ 0.0 };
+  /// Where messages are sent
+  Diagnostics diagnostics{};
+
+  /// The year of the table we are comparing from
+  uint16_t year_before{ 0 };
+  /// The year of the table we are comparing to
+  uint16_t year_after{ 0 };
+
+  /// Isotopes that are only in the table we are comparing to
+  std::vector<Nuclide> added;
+  /// Isotopes that are only in the table we are comparing from
+  std::vector<Nuclide> removed;
+  /// Every value that has changed, grouped by quantity then ordered by A and Z
+  std::vector<Change> changed;
+
+  /**
+   * Compare 2 tables, both of which must already have been populated. Any previous comparison is discarded.
+   *
+   * \param The table to compare from, normally the older year
+   * \param The table to compare to, normally the newer year
+   *
+   * \return[TRUE] The tables have been compared
+   * \return[FALSE] At least one of the tables has not been populated
+   */
+  [[nodiscard]] bool compare(const MassTable& before, const MassTable& after);
+
+  /**
+   * Create a list of the key of each isotope and its position in the table, sorted by the key
+   *
+   * \param The table to index
+   *
+   * \return The sorted list of keys and positions
+   */
+  [[nodiscard]] static std::vector<std::pair<NuclideKey, uint32_t>> sortedIndex(const std::vector<Isotope>& table);
+
+  /**
+   * Create the header line to be used when writing as a csv
+   *
+   * \param Nothing
+   *
+   * \return The variables names in csv formatted string
+   */
+  [[nodiscard]] static std::string writeCSVHeader() { return { "A,Z,Status,Quantity,Before,After,Delta,Significance" }; }
+
+  /**
+   * Write the added, removed and changed isotopes to a csv file
+   *
+   * \param Nothing
+   *
+   * \return[TRUE] The file has been written
+   * \return[FALSE] No comparison has been made
+   */
+  [[nodiscard]] bool outputDiffToCSV() const;
+};
+
+#endif // TABLEDIFF_HPP
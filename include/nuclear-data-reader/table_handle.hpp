@@ -0,0 +1,226 @@
+/**
+ *
+ * \class TableHandle
+ *
+ * \brief Shared access to the latest version of a table, which can be reloaded without stopping the readers
+ *
+ * Each reload populates a new MassTable, from a copy of the prototype the handle was created with, and publishes a
+ * TableSnapshot of it by swapping a single atomic pointer. Readers pin whichever version is current when they ask for
+ * it, which costs one atomic increment and no locks, and keep using it until the pin is dropped. Lookups carry on at
+ * the same speed during a reload as they never wait for it.
+ *
+ * The version that is replaced is deleted once every reader that could have pinned it has unpinned. Readers pin through
+ * one of two counters, chosen by the current epoch. After the swap the reloading thread moves the epoch on, so new
+ * readers use the other counter, and waits for the old counter to reach zero. Doing this twice covers a reader that
+ * picked its counter just before the epoch moved. Only the reloading thread ever waits, so pins should be short lived.
+ */
+#ifndef TABLEHANDLE_HPP
+#define TABLEHANDLE_HPP
+
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/table_snapshot.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+
+class TableHandle
+{
+private:
+  /**
+   * \struct Version
+   *
+   * \brief A published snapshot and the order in which it was published
+   */
+  struct Version
+  {
+    Version(const MassTable& table, const uint64_t _number) : snapshot(table), number(_number) {}
+
+    const TableSnapshot snapshot;
+    const uint64_t number{ 0 };
+  };
+
+public:
+  /**
+   * Nothing is loaded until reload() or reloadInBackground() is called
+   *
+   * \param The table that is copied and populated by every reload, with the year, fields, load mode and diagnostics
+   *        that should be used
+   */
+  explicit TableHandle(MassTable _prototype) : prototype(std::move(_prototype)) {}
+
+  TableHandle(const TableHandle&) = delete;
+  TableHandle(TableHandle&&)      = delete;
+
+  TableHandle& operator=(const TableHandle&) = delete;
+  TableHandle& operator=(TableHandle&&)      = delete;
+
+  /// Waits for a background reload to finish. No Pin can outlive the handle.
+  ~TableHandle();
+
+  /**
+   * \class Pin
+   *
+   * \brief Keeps a version of the table alive for as long as it exists
+   */
+  class Pin
+  {
+  public:
+    Pin() = default;
+
+    Pin(const Pin&)            = delete;
+    Pin& operator=(const Pin&) = delete;
+
+    Pin(Pin&& other) noexcept :
+        version(std::exchange(other.version, nullptr)), readers(std::exchange(other.readers, nullptr))
+    {
+    }
+    Pin& operator=(Pin&& other) noexcept
+    {
+      release();
+      version = std::exchange(other.version, nullptr);
+      readers = std::exchange(other.readers, nullptr);
+      return *this;
+    }
+
+    ~Pin() { release(); }
+
+    /**
+     * Has a version been pinned, there is nothing to pin until the first reload succeeds
+     *
+     * \param Nothing
+     *
+     * \return[TRUE] There is a version to read from
+     * \return[FALSE] The pin is empty
+     */
+    [[nodiscard]] explicit inline operator bool() const noexcept { return version != nullptr; }
+
+    /// The pinned table, the pin must not be empty
+    [[nodiscard]] inline const TableSnapshot& operator*() const noexcept { return version->snapshot; }
+    [[nodiscard]] inline const TableSnapshot* operator->() const noexcept { return &version->snapshot; }
+
+    /**
+     * Which version has been pinned, the first successful reload publishes version 1
+     *
+     * \param Nothing
+     *
+     * \return The version number, 0 if the pin is empty
+     */
+    [[nodiscard]] inline uint64_t number() const noexcept { return version ? version->number : 0; }
+
+    /**
+     * Stop using the pinned version, done automatically when the pin is destroyed
+     *
+     * \param Nothing
+     *
+     * \return Nothing
+     */
+    inline void release() noexcept
+    {
+      if (readers != nullptr)
+        {
+          readers->fetch_sub(1, std::memory_order_release);
+        }
+      version = nullptr;
+      readers = nullptr;
+    }
+
+  private:
+    friend class TableHandle;
+
+    Pin(const Version* _version, std::atomic<uint32_t>* _readers) noexcept : version(_version), readers(_readers) {}
+
+    const Version* version{ nullptr };
+    std::atomic<uint32_t>* readers{ nullptr };
+  };
+
+  /// The table that is copied and populated by every reload
+  const MassTable prototype;
+
+  /**
+   * Pin the current version of the table. Never blocks, and can be called from any number of threads.
+   *
+   * \param Nothing
+   *
+   * \return The pin, which is empty if nothing has been loaded yet
+   */
+  [[nodiscard]] Pin pin() const noexcept;
+
+  /**
+   * Populate a new table, publish it and delete the version it replaces once nobody is reading it.
+   * Reloads are done one at a time, readers are not affected. Must not be called while holding a Pin, as it would wait
+   * for itself.
+   *
+   * \param Nothing
+   *
+   * \return[TRUE] The new version has been published
+   * \return[FALSE] The table could not be populated, the current version is kept
+   */
+  [[nodiscard]] bool reload();
+
+  /**
+   * Call reload() on a separate thread
+   *
+   * \param Nothing
+   *
+   * \return[TRUE] The reload has been started
+   * \return[FALSE] A background reload is already running, so another has not been started
+   */
+  [[nodiscard]] bool reloadInBackground();
+
+  /**
+   * Is a background reload running
+   *
+   * \param Nothing
+   *
+   * \return[TRUE] A reload has been started and not yet finished
+   * \return[FALSE] There is no background reload
+   */
+  [[nodiscard]] inline bool reloading() const noexcept { return loading.load(); }
+
+  /**
+   * The number of the version that is currently published
+   *
+   * \param Nothing
+   *
+   * \return The version number, 0 if nothing has been published
+   */
+  [[nodiscard]] inline uint64_t version() const noexcept { return published.load(); }
+
+private:
+  /// The version that new pins get
+  std::atomic<const Version*> current{ nullptr };
+  /// Number of the last version to be published
+  std::atomic<uint64_t> published{ 0 };
+
+  /// Readers using the counters, kept on separate cache lines so readers and the reloading thread don't share one
+  struct alignas(64) ReaderCount
+  {
+    std::atomic<uint32_t> count{ 0 };
+  };
+  mutable std::array<ReaderCount, 2> readers{};
+  /// The lowest bit selects the counter that new readers use
+  std::atomic<uint32_t> epoch{ 0 };
+
+  /// Only one reload publishes at a time
+  std::mutex reload_mutex;
+  /// A background reload is running
+  std::atomic<bool> loading{ false };
+  /// The thread of the last background reload
+  std::thread loader;
+
+  /**
+   * Wait until nobody can still be reading a version that is no longer current
+   *
+   * \param Nothing
+   *
+   * \return Nothing
+   */
+  void waitForReaders();
+};
+
+#endif // TABLEHANDLE_HPP
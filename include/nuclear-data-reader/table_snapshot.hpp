@@ -0,0 +1,204 @@
+/**
+ *
+ * \class TableSnapshot
+ *
+ * \brief An immutable copy of a populated MassTable that can be shared between threads
+ *
+ * MassTable, and the data it stores, is built to be filled in place so nearly all of it is mutable and some of the
+ * const functions change it, e.g. reading deferred reaction files. A snapshot copies the values out of a populated
+ * table into storage that nothing can change once it has been created. Every function is const, does not allocate
+ * unless it returns a container, and returns either a copy or a view of data that never changes. Any number of
+ * threads can therefore read from the same snapshot, with no locking, for as long as it exists.
+ *
+ * Isotopes are stored in rows, in the order of MassTable::fullDataTable, and can be located by (A, Z) or by their
+ * position on the chart.
+ */
+#ifndef TABLESNAPSHOT_HPP
+#define TABLESNAPSHOT_HPP
+
+#include "nuclear-data-reader/chart_index.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/nubase_decay_branch.hpp"
+#include "nuclear-data-reader/nubase_isomer_table.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+class TableSnapshot
+{
+public:
+  /**
+   * Copy the data out of a populated table. Reaction files that were deferred are read first, so the snapshot is
+   * complete whatever load mode the table used.
+   *
+   * \param The populated table
+   */
+  explicit TableSnapshot(const MassTable& table);
+
+  TableSnapshot(const TableSnapshot&)     = default;
+  TableSnapshot(TableSnapshot&&) noexcept = default;
+
+  // Assigning would change a snapshot that other threads may be reading
+  TableSnapshot& operator=(const TableSnapshot&) = delete;
+  TableSnapshot& operator=(TableSnapshot&&)      = delete;
+
+  ~TableSnapshot() = default;
+
+  /**
+   * \struct Nuclide
+   *
+   * \brief Where a row of the snapshot sits on the chart
+   */
+  struct Nuclide
+  {
+    uint16_t A{ 0 };
+    uint16_t Z{ 0 };
+    uint16_t N{ 0 };
+  };
+
+  /**
+   * The year of the table the snapshot was taken from
+   *
+   * \param Nothing
+   *
+   * \return The year
+   */
+  [[nodiscard]] inline uint16_t getYear() const noexcept { return year; }
+
+  /**
+   * The number of isotopes (rows) in the snapshot
+   *
+   * \param Nothing
+   *
+   * \return The number of isotopes
+   */
+  [[nodiscard]] inline std::size_t size() const noexcept { return nuclides.size(); }
+
+  /**
+   * Where the isotope in a row sits on the chart
+   *
+   * \param The row
+   *
+   * \return The A, Z and N of the isotope. The row must exist.
+   */
+  [[nodiscard]] inline Nuclide nuclide(const std::size_t row) const noexcept { return nuclides[row]; }
+
+  /**
+   * Find the row of an isotope, with a single access of the grid of the chart index
+   *
+   * \param The mass number of the isotope
+   * \param The proton number of the isotope
+   *
+   * \return[PASS] The row of the isotope
+   * \return[FAIL] An empty optional if the isotope is not in the snapshot
+   */
+  [[nodiscard]] std::optional<std::size_t> find(const uint16_t A, const uint16_t Z) const noexcept;
+
+  /**
+   * Get a value of the isotope in a row
+   *
+   * \param The row
+   * \param The value to get
+   *
+   * \return The value, as Isotope::getQuantity() would give it. The row must exist.
+   */
+  [[nodiscard]] inline Number getQuantity(const std::size_t row, const Quantity quantity) const noexcept
+  {
+    return values[row * all_quantities.size() + static_cast<std::size_t>(quantity)];
+  }
+
+  /**
+   * Get a value of a single isotope
+   *
+   * \param The mass number of the isotope
+   * \param The proton number of the isotope
+   * \param The value to get
+   *
+   * \return[PASS] The value
+   * \return[FAIL] An empty optional if the isotope is not in the snapshot
+   */
+  [[nodiscard]] std::optional<Number> getQuantity(const uint16_t A, const uint16_t Z, const Quantity quantity) const;
+
+  /**
+   * Get all of the decay branches of a single isotope
+   *
+   * \param The mass number of the isotope
+   * \param The proton number of the isotope
+   *
+   * \return The branches, in the order they are given in the data file, empty if the isotope is not in the snapshot
+   */
+  [[nodiscard]] std::span<const NUBASE::DecayBranch> getDecayBranches(const uint16_t A,
+                                                                      const uint16_t Z) const noexcept;
+
+  /**
+   * Get all of the excited states of a single isotope
+   *
+   * \param The mass number of the isotope
+   * \param The proton number of the isotope
+   *
+   * \return The states, in order of increasing level, empty if the isotope is not in the snapshot
+   */
+  [[nodiscard]] std::span<const NUBASE::IsomerState> getIsomers(const uint16_t A, const uint16_t Z) const noexcept;
+
+  /**
+   * Get the rows of all of the isotopes in a rectangular region of the chart, boundaries are inclusive
+   *
+   * \param The minimum proton number
+   * \param The maximum proton number
+   * \param The minimum neutron number
+   * \param The maximum neutron number
+   *
+   * \return The rows, ordered by Z then N
+   */
+  [[nodiscard]] inline std::vector<uint32_t>
+  getRegion(const uint16_t Zmin, const uint16_t Zmax, const uint16_t Nmin, const uint16_t Nmax) const
+  {
+    return index.region(Zmin, Zmax, Nmin, Nmax);
+  }
+
+  /**
+   * Get the rows of the isotopic, isotonic or isobaric chain
+   *
+   * \param The proton, neutron or mass number of the chain
+   *
+   * \return The rows, ordered by N for an isotopic chain and by Z for the others
+   */
+  [[nodiscard]] inline std::span<const uint32_t> isotopicChain(const uint16_t Z) const noexcept
+  {
+    return index.isotopicChain(Z);
+  }
+  [[nodiscard]] inline std::span<const uint32_t> isotonicChain(const uint16_t N) const noexcept
+  {
+    return index.isotonicChain(N);
+  }
+  [[nodiscard]] inline std::span<const uint32_t> isobaricChain(const uint16_t A) const noexcept
+  {
+    return index.isobaricChain(A);
+  }
+
+private:
+  /// The year of the table the snapshot was taken from
+  uint16_t year{};
+  /// The position on the chart of every row
+  std::vector<Nuclide> nuclides;
+  /// Every quantity of every row, all_quantities.size() values per row in the order of Quantity
+  std::vector<Number> values;
+  /// Locate rows by their position on the chart
+  ChartIndex index{};
+
+  /// The decay branches of row i are branches[branch_offsets[i]] to branches[branch_offsets[i + 1]]
+  std::vector<NUBASE::DecayBranch> branches;
+  std::vector<uint32_t> branch_offsets{ 0 };
+
+  /// The excited states of row i are isomers[isomer_offsets[i]] to isomers[isomer_offsets[i + 1]]
+  std::vector<NUBASE::IsomerState> isomers;
+  std::vector<uint32_t> isomer_offsets{ 0 };
+};
+
+#endif // TABLESNAPSHOT_HPP
@@ -0,0 +1,9 @@
+#ifndef VERSION_HPP
+#define VERSION_HPP
+
+#define NDR_VERSION "0.0.1"
+#define NDR_VERSION_MAJOR 0
+#define NDR_VERSION_MINOR 0
+#define NDR_VERSION_PATCH 1
+
+#endif // VERSION_HPP
@@ -0,0 +1,407 @@
+/**
+ *
+ * ndr-serve
+ *
+ * Hold the tables of a set of years in memory and answer requests for them over a Unix domain socket, so that many
+ * processes can share one copy. The format of the requests is described in query_protocol.hpp.
+ *
+ * Usage: ndr-serve <socket path> [year ...]
+ *
+ * All years are served if none are given. Sending SIGHUP reloads every table from its data files, requests continue to
+ * be answered while this happens. SIGINT or SIGTERM stop the server and remove the socket.
+ */
+#include "nuclear-data-reader/query_engine.hpp"
+
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/query_protocol.hpp"
+
+#include <fmt/core.h>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+
+namespace
+{
+  /// Set by the signal handlers, checked by the main loop
+  volatile std::sig_atomic_t stop_requested{ 0 };
+  volatile std::sig_atomic_t reload_requested{ 0 };
+
+  /// How much is read from a connection at a time
+  constexpr std::size_t READ_SIZE{ 1U << 16 };
+  /// Stop reading once this much has been received, enough for the largest request
+  constexpr std::size_t INPUT_LIMIT{ sizeof(Query::RequestHeader) + Query::MAX_PAYLOAD_SIZE };
+  /// Stop reading and answering once this much is waiting to be sent, until the client has read some of it
+  constexpr std::size_t OUTPUT_HIGH_WATER{ 1U << 24 };
+
+  /**
+   * \struct Connection
+   *
+   * \brief A connected client and the bytes waiting to be processed or sent
+   */
+  struct Connection
+  {
+    int fd{ -1 };
+    /// Received, but not yet a complete request
+    std::vector<std::byte> input;
+    /// Responses that have not yet been sent
+    std::vector<std::byte> output;
+    /// How much of output has been sent
+    std::size_t sent{ 0 };
+    /// The client has finished sending, answer what has arrived then close
+    bool finished{ false };
+
+    /**
+     * How much is waiting to be sent
+     *
+     * \param Nothing
+     *
+     * \return The number of bytes
+     */
+    [[nodiscard]] inline std::size_t waiting() const noexcept { return output.size() - sent; }
+
+    /**
+     * Should more be read from the client
+     *
+     * \param Nothing
+     *
+     * \return[TRUE] The client may send more and there is room for it and its responses
+     * \return[FALSE] Otherwise
+     */
+    [[nodiscard]] inline bool wantsInput() const noexcept
+    {
+      return !finished && input.size() < INPUT_LIMIT && waiting() < OUTPUT_HIGH_WATER;
+    }
+  };
+
+  /**
+   * Did a call on a non-blocking socket fail only because it would have had to wait
+   *
+   * \param The value of errno after the call
+   *
+   * \return[TRUE] The call would have blocked
+   * \return[FALSE] It failed for another reason
+   */
+  [[nodiscard]] inline bool wouldBlock(const int error) noexcept
+  {
+    // The two are the same on Linux, where comparing against both is a warning
+#if EAGAIN != EWOULDBLOCK
+    return error == EAGAIN || error == EWOULDBLOCK;
+#else
+    return error == EAGAIN;
+#endif
+  }
+
+  /**
+   * Create the listening socket, replacing a socket left at the path by an earlier run
+   *
+   * \param The path of the socket
+   *
+   * \return The file descriptor of the socket, -1 if it could not be created
+   */
+  int listenOn(const std::string& path)
+  {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path))
+      {
+        fmt::print(stderr, "**ERROR**: The socket path {} is too long\n", path);
+        return -1;
+      }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    // Only replace a socket left behind by an earlier run, anything else at the path is not ours to delete
+    std::error_code error;
+    const auto existing = std::filesystem::symlink_status(path, error);
+    if (std::filesystem::exists(existing))
+      {
+        if (!std::filesystem::is_socket(existing))
+          {
+            fmt::print(stderr, "**ERROR**: {} already exists and is not a socket\n", path);
+            return -1;
+          }
+        std::filesystem::remove(path, error);
+      }
+
+    const auto fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+      {
+        fmt::print(stderr, "**ERROR**: Could not create a socket: {}\n", std::strerror(errno));
+        return -1;
+      }
+
+    // sockaddr_un has to be passed as a sockaddr, there is no other way
+    // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast)
+    if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0)
+      {
+        fmt::print(stderr, "**ERROR**: Could not listen on {}: {}\n", path, std::strerror(errno));
+        close(fd);
+        return -1;
+      }
+
+    return fd;
+  }
+
+  /**
+   * Read what is available from a connection, up to INPUT_LIMIT
+   *
+   * \param The connection
+   *
+   * \return[TRUE] The connection is still open, though the client may have finished sending
+   * \return[FALSE] The connection has failed
+   */
+  bool receive(Connection& connection)
+  {
+    while (connection.input.size() < INPUT_LIMIT)
+      {
+        const auto offset = connection.input.size();
+        connection.input.resize(offset + READ_SIZE);
+
+        const auto received = read(connection.fd, connection.input.data() + offset, READ_SIZE);
+        connection.input.resize(offset + static_cast<std::size_t>(received > 0 ? received : 0));
+
+        if (received == 0)
+          {
+            // Anything already received is still answered
+            connection.finished = true;
+            return true;
+          }
+        if (received < 0)
+          {
+            if (errno == EINTR)
+              {
+                continue;
+              }
+            return wouldBlock(errno);
+          }
+      }
+
+    return true;
+  }
+
+  /**
+   * Answer the complete requests that have been received, stopping if too much is waiting to be sent
+   *
+   * \param The engine that answers the requests
+   * \param The connection
+   *
+   * \return[PASS] The number of bytes of input that were answered
+   * \return[FAIL] An empty optional if the client sent something that is not a request
+   */
+  std::optional<std::size_t> answer(const QueryEngine& engine, Connection& connection)
+  {
+    // Drop what has already been sent, so the output only holds what is waiting
+    connection.output.erase(connection.output.begin(),
+                            std::next(connection.output.begin(), static_cast<std::ptrdiff_t>(connection.sent)));
+    connection.sent = 0;
+
+    // The client may have sent many requests before reading any of the responses
+    const auto used = engine.process(connection.input, connection.output, OUTPUT_HIGH_WATER);
+    if (used)
+      {
+        connection.input.erase(connection.input.begin(),
+                               std::next(connection.input.begin(), static_cast<std::ptrdiff_t>(used.value())));
+      }
+    return used;
+  }
+
+  /**
+   * Send as much of the waiting responses as the connection will take
+   *
+   * \param The connection
+   *
+   * \return[TRUE] The connection is still open
+   * \return[FALSE] The client has gone
+   */
+  bool transmit(Connection& connection)
+  {
+    while (connection.sent < connection.output.size())
+      {
+        const auto written = send(connection.fd,
+                                  connection.output.data() + connection.sent,
+                                  connection.output.size() - connection.sent,
+                                  MSG_NOSIGNAL);
+        if (written < 0)
+          {
+            if (errno == EINTR)
+              {
+                continue;
+              }
+            return wouldBlock(errno);
+          }
+        connection.sent += static_cast<std::size_t>(written);
+      }
+
+    connection.output.clear();
+    connection.sent = 0;
+    return true;
+  }
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+  const std::span<char*> arguments(argv, static_cast<std::size_t>(argc));
+  if (arguments.size() < 2)
+    {
+      fmt::print(stderr, "Usage: {} <socket path> [year ...]\n", arguments[0]);
+      return EXIT_FAILURE;
+    }
+  const std::string socket_path{ arguments[1] };
+
+  std::vector<uint16_t> years;
+  for (const auto* const argument : arguments.subspan(2))
+    {
+      const auto year = static_cast<uint16_t>(std::strtoul(argument, nullptr, 10));
+      if (!MassTable(year).ValidYear(year))
+        {
+          fmt::print(stderr, "**ERROR**: {} is not a valid year\n", argument);
+          return EXIT_FAILURE;
+        }
+      years.push_back(year);
+    }
+  if (years.empty())
+    {
+      years.assign(MassTable::valid_years.cbegin(), MassTable::valid_years.cend());
+    }
+
+  QueryEngine engine(years);
+  if (!engine.load())
+    {
+      fmt::print(stderr, "**ERROR**: Not all of the tables could be loaded\n");
+      return EXIT_FAILURE;
+    }
+
+  struct sigaction action
+  {
+  };
+  action.sa_handler = [](int signal) {
+    if (signal == SIGHUP)
+      {
+        reload_requested = 1;
+      }
+    else
+      {
+        stop_requested = 1;
+      }
+  };
+  sigemptyset(&action.sa_mask);
+  // No SA_RESTART, so poll() returns as soon as a signal arrives
+  sigaction(SIGINT, &action, nullptr);
+  sigaction(SIGTERM, &action, nullptr);
+  sigaction(SIGHUP, &action, nullptr);
+
+  const auto listener = listenOn(socket_path);
+  if (listener < 0)
+    {
+      return EXIT_FAILURE;
+    }
+  fmt::print("Serving {} year(s) on {}\n", engine.years().size(), socket_path);
+
+  std::vector<Connection> connections;
+  std::vector<pollfd> polled;
+  while (stop_requested == 0)
+    {
+      if (reload_requested != 0)
+        {
+          reload_requested = 0;
+          fmt::print("Reloading the tables\n");
+          engine.reloadInBackground();
+        }
+
+      polled.assign(1, pollfd{ listener, POLLIN, 0 });
+      for (const auto& connection : connections)
+        {
+          // Only ask for input when there is room for it, so a client that does not read is made to wait
+          const auto input   = connection.wantsInput() ? POLLIN : 0;
+          const auto output  = (connection.waiting() > 0) ? POLLOUT : 0;
+          const short events = static_cast<short>(input | output);
+          polled.push_back(pollfd{ connection.fd, events, 0 });
+        }
+
+      // Wake up regularly in case a signal arrived just before we started waiting
+      if (poll(polled.data(), polled.size(), 1000) < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+          fmt::print(stderr, "**ERROR**: poll failed: {}\n", std::strerror(errno));
+          break;
+        }
+
+      // Connections that are accepted now are not in polled, so only look at those that were
+      const auto existing = connections.size();
+      if ((polled[0].revents & POLLIN) != 0)
+        {
+          for (auto fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC); fd >= 0;
+               fd      = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC))
+            {
+              connections.push_back(Connection{ fd, {}, {}, 0, false });
+            }
+        }
+
+      for (std::size_t i = 0; i < existing; ++i)
+        {
+          auto& connection   = connections[i];
+          const auto revents = polled[i + 1].revents;
+          auto open          = (revents & (POLLERR | POLLNVAL)) == 0;
+
+          if (open && connection.wantsInput() && (revents & (POLLIN | POLLHUP)) != 0)
+            {
+              open = receive(connection);
+            }
+
+          // Answer and send until either the client stops reading or there is nothing left to answer
+          while (open)
+            {
+              const auto used = (connection.waiting() < OUTPUT_HIGH_WATER) ? answer(engine, connection)
+                                                                           : std::optional<std::size_t>{ 0 };
+              open = used && transmit(connection);
+              if (!open || used.value() == 0 || connection.waiting() > 0)
+                {
+                  break;
+                }
+            }
+
+          // Everything that can be answered has been sent, anything left is a partial request
+          if (open && connection.finished && connection.waiting() == 0)
+            {
+              open = false;
+            }
+          if (!open)
+            {
+              close(connection.fd);
+              connection.fd = -1;
+            }
+        }
+
+      std::erase_if(connections, [](const Connection& connection) { return connection.fd < 0; });
+    }
+
+  for (const auto& connection : connections)
+    {
+      close(connection.fd);
+    }
+  close(listener);
+  unlink(socket_path.c_str());
+
+  return EXIT_SUCCESS;
+}
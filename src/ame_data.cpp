@@ -6,12 +6,11 @@
 double AME::Data::getRelativeMassExcessError(const double min_allowed) const
 {
   // 12C has an mass excess of 0.0 by definition.
-  // This is the only place it currently trips us up and this path does not always happen so, in terms of doing as
-  // little work as possible, this is the best place to check and make adjustments.
-  // The value we set does not matter as the error on the value is also 0.0 so relative error is guaranteed to be 0.0
+  // This is the only place it currently trips us up. The error on the value is also 0.0 so the relative error is 0.0,
+  // rather than the 0.0/0.0 we would calculate, and the stored value is left alone so this can be called concurrently.
   if (A == 12 && Z == 6)
     {
-      mass_excess.amount = 0.0001;
+      return std::max(0.0, min_allowed);
     }
 
   // Optional access is check in function so silence the linter for that specific check
@@ -0,0 +1,193 @@
+#include "nuclear-data-reader/chart_grid.hpp"
+
+#include "nuclear-data-reader/chart_index.hpp"
+#include "nuclear-data-reader/converter.hpp"
+#include "nuclear-data-reader/diagnostics.hpp"
+#include "nuclear-data-reader/isotope.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+#include <fmt/os.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+bool ChartGrid::fill(const MassTable& table, const Quantity _quantity)
+{
+  if (table.fullDataTable.empty())
+    {
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::OUT_OF_ORDER },
+                         []() { return std::string("The table must be populated before the grid can be filled\n"); });
+      return false;
+    }
+
+  if (isReactionQuantity(_quantity))
+    {
+      table.readDeferredReactions();
+    }
+
+  if (table.chart_index.empty())
+    {
+      table.buildIndex();
+    }
+
+  const auto& index = table.chart_index;
+
+  year     = table.year;
+  quantity = _quantity;
+  rows     = static_cast<uint16_t>(index.grid_height);
+  columns  = static_cast<uint16_t>(index.grid_width);
+
+  constexpr auto missing = std::numeric_limits<double>::quiet_NaN();
+  value.assign(index.grid.size(), missing);
+  error.assign(index.grid.size(), missing);
+  exists.assign(index.grid.size(), 0);
+
+  // The grid of the index has the same layout, so each slot is copied straight across
+  for (std::size_t point = 0; point < index.grid.size(); ++point)
+    {
+      const auto position = index.grid[point];
+      if (position == ChartIndex::NO_ISOTOPE || position >= table.fullDataTable.size())
+        {
+          continue;
+        }
+
+      exists[point] = 1;
+
+      const auto number = table.fullDataTable[position].getQuantity(quantity);
+      if (!Number::isMissing(number.amount))
+        {
+          value[point] = number.amount;
+        }
+      if (number.uncertainty && !Number::isMissing(number.uncertainty.value()))
+        {
+          error[point] = number.uncertainty.value();
+        }
+    }
+
+  return true;
+}
+
+
+std::optional<Number> ChartGrid::at(const uint16_t Z, const uint16_t N) const
+{
+  if (Z >= rows || N >= columns)
+    {
+      return std::nullopt;
+    }
+
+  const auto position = slot(Z, N);
+  if (std::isnan(value[position]))
+    {
+      return std::nullopt;
+    }
+
+  return std::isnan(error[position]) ? Number{ value[position] } : Number{ value[position], error[position] };
+}
+
+
+std::array<char, ChartGrid::BINARY_HEADER_SIZE> ChartGrid::writeBinaryHeader() const noexcept
+{
+  constexpr std::array<char, 8> magic{ 'N', 'D', 'R', 'G', 'R', 'D', '0', '1' };
+  const auto stored = static_cast<uint8_t>(quantity);
+
+  std::array<char, BINARY_HEADER_SIZE> header{};
+  std::memcpy(header.data(), magic.data(), magic.size());
+  std::memcpy(header.data() + 8, &year, sizeof(year));
+  std::memcpy(header.data() + 10, &stored, sizeof(stored));
+  std::memcpy(header.data() + 12, &rows, sizeof(rows));
+  std::memcpy(header.data() + 14, &columns, sizeof(columns));
+
+  return header;
+}
+
+
+bool ChartGrid::outputGridToBinary() const
+{
+  if (year == 0)
+    {
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::OUT_OF_ORDER },
+                         []() { return std::string("The grid must be filled before it can be written\n"); });
+      return false;
+    }
+
+  const std::filesystem::path outfile{ fmt::format("masstable_{}_{}.bin", year, printQuantity(quantity)) };
+
+  std::ofstream out(outfile, std::ios::binary);
+  if (!out)
+    {
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::FILE_NOT_WRITTEN, &outfile }, [&outfile]() {
+        return fmt::format("\n***ERROR***: {} could not be opened for writing\n\n", outfile.string());
+      });
+      return false;
+    }
+
+  const auto header = writeBinaryHeader();
+  out.write(header.data(), static_cast<std::streamsize>(header.size()));
+  // The vectors are already in the layout of the file so are written in one go
+  out.write(reinterpret_cast<const char*>(value.data()), static_cast<std::streamsize>(value.size() * sizeof(double)));
+  out.write(reinterpret_cast<const char*>(error.data()), static_cast<std::streamsize>(error.size() * sizeof(double)));
+  out.write(reinterpret_cast<const char*>(exists.data()), static_cast<std::streamsize>(exists.size()));
+  out.close();
+
+  if (!out)
+    {
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::FILE_NOT_WRITTEN, &outfile }, [&outfile]() {
+        return fmt::format("\n***ERROR***: {} was not completely written\n\n", outfile.string());
+      });
+      return false;
+    }
+
+  diagnostics.report({ Severity::INFO, DiagnosticCode::FILE_WRITTEN, &outfile },
+                     [&outfile]() { return fmt::format("New binary formatted file: {}\n", outfile.string()); });
+
+  return true;
+}
+
+
+bool ChartGrid::outputGridToMatrix() const
+{
+  if (year == 0)
+    {
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::OUT_OF_ORDER },
+                         []() { return std::string("The grid must be filled before it can be written\n"); });
+      return false;
+    }
+
+  const std::filesystem::path outfile{ fmt::format("masstable_{}_{}.dat", year, printQuantity(quantity)) };
+
+  diagnostics.report({ Severity::INFO, DiagnosticCode::FILE_WRITTEN, &outfile },
+                     [&outfile]() { return fmt::format("New matrix formatted file: {}\n", outfile.string()); });
+  auto out = fmt::output_file(outfile.string());
+
+  out.print("# {} from the {} table\n", printQuantity(quantity), year);
+  out.print("# {} rows (Z = 0 to {}) by {} columns (N = 0 to {})\n", rows, rows - 1, columns, columns - 1);
+
+  std::string line;
+  for (std::size_t row = 0; row < rows; ++row)
+    {
+      line.clear();
+      for (std::size_t column = 0; column < columns; ++column)
+        {
+          const auto amount = value[row * columns + column];
+          line += (column == 0) ? "" : " ";
+          line += std::isnan(amount) ? std::string("NaN") : Converter::FloatToNdp(amount, Isotope::NDP);
+        }
+      out.print("{}\n", line);
+    }
+
+  return true;
+}
@@ -0,0 +1,135 @@
+#include "nuclear-data-reader/chart_index.hpp"
+
+#include "nuclear-data-reader/ame_data.hpp"
+#include "nuclear-data-reader/isotope.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+
+namespace
+{
+  /**
+   * Order the table positions by one value, then a second, and create the offset table for the first value
+   *
+   * \param The table being indexed
+   * \param Function to get the value to order by from an isotope
+   * \param Function to get the value to order by within each group of the first
+   * \param The ordering to fill
+   * \param The offsets to fill
+   *
+   * \return Nothing
+   */
+  template<typename Key, typename Within>
+  void orderBy(const std::vector<Isotope>& table,
+               Key key,
+               Within within,
+               std::vector<uint32_t>& order,
+               std::vector<uint32_t>& offset)
+  {
+    order.resize(table.size());
+    std::iota(order.begin(), order.end(), 0U);
+
+    // Stable so any duplicates (isomers in the older tables) keep the order they were read in
+    std::stable_sort(order.begin(), order.end(), [&](const uint32_t lhs, const uint32_t rhs) {
+      const auto& left  = table[lhs].ame;
+      const auto& right = table[rhs].ame;
+      return (key(left) != key(right)) ? key(left) < key(right) : within(left) < within(right);
+    });
+
+    // Count the isotopes with each value, then accumulate to get where each one starts
+    offset.assign(static_cast<std::size_t>(key(table[order.back()].ame)) + 2, 0U);
+    for (const auto position : order)
+      {
+        ++offset[static_cast<std::size_t>(key(table[position].ame)) + 1];
+      }
+    std::partial_sum(offset.begin(), offset.end(), offset.begin());
+  }
+} // namespace
+
+
+void ChartIndex::build(const std::vector<Isotope>& table)
+{
+  clear();
+
+  if (table.empty())
+    {
+      return;
+    }
+
+  const auto get_Z = [](const AME::Data& ame) { return ame.Z; };
+  const auto get_N = [](const AME::Data& ame) { return ame.N; };
+  const auto get_A = [](const AME::Data& ame) { return ame.A; };
+
+  orderBy(table, get_Z, get_N, by_Z, Z_offset);
+  orderBy(table, get_N, get_Z, by_N, N_offset);
+  orderBy(table, get_A, get_Z, by_A, A_offset);
+
+  N_by_Z.reserve(by_Z.size());
+  for (const auto position : by_Z)
+    {
+      N_by_Z.push_back(table[position].ame.N);
+    }
+
+  // The offset tables have an entry beyond the largest value
+  grid_height = Z_offset.size() - 1;
+  grid_width  = N_offset.size() - 1;
+  grid.assign(grid_height * grid_width, NO_ISOTOPE);
+  for (const auto position : by_Z)
+    {
+      const auto& ame = table[position].ame;
+      auto& slot      = grid[gridSlot(ame.Z, ame.N)];
+      if (slot == NO_ISOTOPE)
+        {
+          slot = position;
+        }
+    }
+}
+
+
+void ChartIndex::clear() noexcept
+{
+  by_Z.clear();
+  N_by_Z.clear();
+  Z_offset.clear();
+  by_N.clear();
+  N_offset.clear();
+  by_A.clear();
+  A_offset.clear();
+  grid.clear();
+  grid_height = 0;
+  grid_width  = 0;
+}
+
+
+std::vector<uint32_t>
+ChartIndex::region(const uint16_t Zmin, const uint16_t Zmax, const uint16_t Nmin, const uint16_t Nmax) const
+{
+  std::vector<uint32_t> found;
+
+  if (empty() || Zmin > Zmax || Nmin > Nmax)
+    {
+      return found;
+    }
+
+  const auto last_Z = std::min<std::size_t>(Zmax, Z_offset.size() - 2);
+  for (std::size_t Z = Zmin; Z <= last_Z; ++Z)
+    {
+      const auto row_start = std::next(N_by_Z.cbegin(), Z_offset[Z]);
+      const auto row_end   = std::next(N_by_Z.cbegin(), Z_offset[Z + 1]);
+
+      // N is sorted within a row so only the ends need to be searched for
+      const auto first = std::lower_bound(row_start, row_end, Nmin);
+      const auto last  = std::upper_bound(first, row_end, Nmax);
+
+      found.insert(found.end(),
+                   std::next(by_Z.cbegin(), std::distance(N_by_Z.cbegin(), first)),
+                   std::next(by_Z.cbegin(), std::distance(N_by_Z.cbegin(), last)));
+    }
+
+  return found;
+}
@@ -1,46 +1,133 @@
 #include "nuclear-data-reader/converter.hpp"
 
 #include <string_view>
+#include <system_error>
 
 #include <fmt/core.h>
 
 #include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <optional>
+#include <span>
 #include <string>
 #include <utility>
 
 
+// The table is ordered by Z, with no gaps, so we can index directly into it
+static_assert(
+    []() {
+      for (std::size_t Z = 0; Z < Converter::symbolZmap.size(); ++Z)
+        {
+          if (Converter::symbolZmap[Z].second != Z)
+            {
+              return false;
+            }
+        }
+      return true;
+    }(),
+    "Converter::symbolZmap must be ordered by Z");
+
+
 std::optional<std::string_view> Converter::ZToSymbol(const uint16_t proton_number)
 {
-  const auto symbol = std::find_if(symbolZmap.cbegin(), symbolZmap.cend(), [proton_number](const auto& element) {
-    return element.second == proton_number;
-  });
-
-  if (symbol == symbolZmap.cend()) [[unlikely]]
+  if (proton_number >= symbolZmap.size()) [[unlikely]]
     {
       return std::nullopt;
     }
 
-  return symbol->first;
+  return symbolZmap[proton_number].first;
 }
 
 
 std::optional<uint16_t> Converter::SymbolToZ(const std::string_view symbol)
 {
-  // FIXME: Check that the string format matches that in the map,
-  // i.e. first character capital letter, 2nd (if it exists) lower case ^[A-Z]{1}[a-z]?$
-  const auto proton_number = std::find_if(
-      symbolZmap.cbegin(), symbolZmap.cend(), [symbol](const auto& element) { return element.first == symbol; });
+  if (symbol == "n")
+    {
+      return 0;
+    }
+
+  const auto slot = symbol_hash(symbol);
+
+  if (slot == SYMBOL_HASH_SIZE || symbolTable[slot] == NO_ELEMENT) [[unlikely]]
+    {
+      return std::nullopt;
+    }
+
+  return symbolTable[slot];
+}
+
+
+std::optional<std::pair<uint16_t, uint16_t>> Converter::LabelToAZ(std::string_view label) noexcept
+{
+  label = TrimString(label);
+
+  if (label.empty())
+    {
+      return std::nullopt;
+    }
+
+  const auto is_digit = [](const char character) { return character >= '0' && character <= '9'; };
+
+  // The number can be before or after the symbol, find which and split the string
+  std::string_view number;
+  std::string_view symbol;
+  if (is_digit(label.front()))
+    {
+      const auto split = std::min(label.find_first_not_of("0123456789"), label.size());
+      number           = label.substr(0, split);
+      symbol           = label.substr(split);
+    }
+  else
+    {
+      const auto split = std::min(label.find_first_of("0123456789"), label.size());
+      symbol           = label.substr(0, split);
+      number           = label.substr(split);
 
-  if (proton_number == symbolZmap.cend()) [[unlikely]]
+      // Allow Pb-208
+      if (symbol.ends_with('-'))
+        {
+          symbol.remove_suffix(1);
+        }
+    }
+
+  uint16_t A{ 0 };
+  if (const auto [ptr, ec] = std::from_chars(number.data(), number.data() + number.size(), A);
+      ec != std::errc() || ptr != number.data() + number.size())
+    {
+      return std::nullopt;
+    }
+
+  const auto Z = SymbolToZ(symbol);
+
+  if (!Z || A < Z.value() || A == 0)
     {
       return std::nullopt;
     }
 
-  return proton_number->second;
+  return std::make_pair(A, Z.value());
+}
+
+
+std::size_t Converter::LabelsToAZ(const std::span<const std::string_view> labels,
+                                  std::span<std::optional<std::pair<uint16_t, uint16_t>>> results) noexcept
+{
+  const auto size = std::min(labels.size(), results.size());
+
+  std::size_t converted{ 0 };
+  for (std::size_t i = 0; i < size; ++i)
+    {
+      results[i] = LabelToAZ(labels[i]);
+      if (results[i])
+        {
+          ++converted;
+        }
+    }
+
+  return converted;
 }
 
 
@@ -53,51 +140,25 @@ std::string Converter::FloatToNdp(const double number, const uint8_t numDP) noex
 
 std::chrono::duration<double> Converter::ToDuration(const double value, std::string_view unit) noexcept
 {
-  return [=]() -> std::chrono::duration<double> {
-    switch (Converter::string_hash(unit.data()))
-      {
-        case "ys"_sh:
-          return Converter::attoseconds{ 1.0e-6 * value };
-        case "zs"_sh:
-          return Converter::attoseconds{ 1.0e-3 * value };
-        case "as"_sh:
-          return Converter::attoseconds{ value };
-        case "ps"_sh:
-          return Converter::picoseconds{ value };
-        case "ns"_sh:
-          return Converter::nanoseconds{ value };
-        case "us"_sh:
-          return Converter::microseconds{ value };
-        case "ms"_sh:
-          return Converter::milliseconds{ value };
-        case "s"_sh:
-          return Converter::seconds{ value };
-        case "m"_sh:
-          return Converter::minutes{ value };
-        case "h"_sh:
-          return Converter::hours{ value };
-        case "d"_sh:
-          return Converter::days{ value };
-        case "y"_sh:
-          return Converter::years{ value };
-        case "ky"_sh:
-          return Converter::kiloyears{ value };
-        case "My"_sh:
-          return Converter::millionyears{ value };
-        case "Gy"_sh:
-          return Converter::billionyears{ value };
-        case "Ty"_sh:
-          return Converter::billionyears{ 1.0e3 * value };
-        case "Py"_sh:
-          return Converter::billionyears{ 1.0e6 * value };
-        case "Ey"_sh:
-          return Converter::billionyears{ 1.0e9 * value };
-        case "Zy"_sh:
-          return Converter::billionyears{ 1.0e12 * value };
-        case "Yy"_sh:
-          return Converter::billionyears{ 1.0e15 * value };
-        default:
-          return Converter::seconds{ 1.0e24 };
-      }
-  }();
+  return Converter::ToDuration(value, Converter::ToTimeUnit(unit));
+}
+
+
+std::size_t Converter::ToSeconds(std::span<const double> values,
+                                 std::span<const TimeUnit> units,
+                                 std::span<double> in_seconds) noexcept
+{
+  const auto count = std::min({ values.size(), units.size(), in_seconds.size() });
+
+  for (std::size_t i = 0; i < count; ++i)
+    {
+      // Clamp so a corrupt unit can't read outside of the table, it will pick up the UNKNOWN entry
+      const auto index  = std::min(static_cast<std::size_t>(units[i]), timeScale.size() - 1);
+      const auto& scale = timeScale[index];
+      const auto known  = scale.pre * values[i] * scale.num / scale.den;
+
+      in_seconds[i] = (index == timeScale.size() - 1) ? unknown_unit_seconds : known;
+    }
+
+  return count;
 }
@@ -0,0 +1,334 @@
+#include "nuclear-data-reader/derived_quantities.hpp"
+
+#include "nuclear-data-reader/isotope.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+namespace
+{
+  constexpr auto missing = std::numeric_limits<double>::quiet_NaN();
+
+  /// The nuclides whose masses appear in the formulae, as fixed terms
+  constexpr DerivedQuantities::Term neutron(const int8_t coefficient) { return { 0, 1, coefficient, false }; }
+  constexpr DerivedQuantities::Term hydrogen(const int8_t coefficient) { return { 1, 0, coefficient, false }; }
+  constexpr DerivedQuantities::Term deuteron(const int8_t coefficient) { return { 1, 1, coefficient, false }; }
+  constexpr DerivedQuantities::Term alpha(const int8_t coefficient) { return { 2, 2, coefficient, false }; }
+} // namespace
+
+
+DerivedQuantities::DerivedQuantities(const MassTable& table)
+{
+  for (const auto& ame : table.ameDataTable)
+    {
+      Zmax = std::max(Zmax, ame.Z);
+      Nmax = std::max(Nmax, ame.N);
+    }
+
+  width              = static_cast<std::size_t>(Nmax + 1 + 2 * REACH);
+  const auto height  = static_cast<std::size_t>(Zmax + 1 + 2 * REACH);
+  mass_excess.assign(width * height, missing);
+  variance.assign(width * height, missing);
+
+  for (const auto& ame : table.ameDataTable)
+    {
+      // Older tables list some isomers, keep the first entry as that is the ground state
+      const auto position = slot(ame.Z, ame.N);
+      if (!std::isnan(mass_excess[position]) || Number::isMissing(ame.mass_excess.amount))
+        {
+          continue;
+        }
+
+      const auto error      = ame.mass_excess.uncertainty.value_or(0.0);
+      mass_excess[position] = ame.mass_excess.amount;
+      variance[position]    = Number::isMissing(error) ? missing : error * error;
+    }
+}
+
+
+std::vector<DerivedQuantities::Term> DerivedQuantities::formula(const Quantity quantity)
+{
+  // Separation energies are the mass of the products minus that of the isotope,
+  // Q-values are the mass of the isotope (and projectile) minus that of the products
+  switch (quantity)
+    {
+      case Quantity::S_N:
+        return { { 0, -1, 1 }, neutron(1), { 0, 0, -1 } };
+      case Quantity::S_P:
+        return { { -1, 0, 1 }, hydrogen(1), { 0, 0, -1 } };
+      case Quantity::S_2N:
+        return { { 0, -2, 1 }, neutron(2), { 0, 0, -1 } };
+      case Quantity::S_2P:
+        return { { -2, 0, 1 }, hydrogen(2), { 0, 0, -1 } };
+      case Quantity::Q_ALPHA:
+        return { { 0, 0, 1 }, { -2, -2, -1 }, alpha(-1) };
+      case Quantity::Q_2BM:
+        return { { 0, 0, 1 }, { 2, -2, -1 } };
+      case Quantity::Q_EP:
+        return { { 0, 0, 1 }, { -2, 1, -1 }, hydrogen(-1) };
+      case Quantity::Q_BM_N:
+        return { { 0, 0, 1 }, { 1, -2, -1 }, neutron(-1) };
+      case Quantity::Q_4BM:
+        return { { 0, 0, 1 }, { 4, -4, -1 } };
+      case Quantity::Q_DA:
+        return { { 0, 0, 1 }, deuteron(1), { -1, -1, -1 }, alpha(-1) };
+      case Quantity::Q_PA:
+        return { { 0, 0, 1 }, hydrogen(1), { -1, -2, -1 }, alpha(-1) };
+      case Quantity::Q_NA:
+        return { { 0, 0, 1 }, neutron(1), { -2, -1, -1 }, alpha(-1) };
+      case Quantity::AME_MASS_EXCESS:
+      case Quantity::NUBASE_MASS_EXCESS:
+      case Quantity::BINDING_ENERGY_PER_A:
+      case Quantity::BETA_DECAY_ENERGY:
+      case Quantity::ATOMIC_MASS:
+      case Quantity::HALF_LIFE:
+      default:
+        return {};
+    }
+}
+
+
+std::optional<DerivedQuantities::Column> DerivedQuantities::calculate(std::span<const Term> terms) const
+{
+  if (terms.empty() || mass_excess.empty())
+    {
+      return std::nullopt;
+    }
+
+  // Everything from the first to the last isotope, the border either side is left missing
+  const auto first = slot(0, 0);
+  const auto count = slot(Zmax, Nmax) + 1 - first;
+
+  Column column;
+  column.value.assign(mass_excess.size(), missing);
+  column.error.assign(mass_excess.size(), missing);
+  std::fill_n(std::next(column.value.begin(), static_cast<std::ptrdiff_t>(first)), count, 0.0);
+  std::fill_n(std::next(column.error.begin(), static_cast<std::ptrdiff_t>(first)), count, 0.0);
+
+  // Fixed nuclides add the same amount everywhere, so are summed first and added in one go
+  double constant{ 0.0 };
+  double constant_variance{ 0.0 };
+
+  const std::span<double> value = std::span<double>(column.value).subspan(first, count);
+  const std::span<double> error = std::span<double>(column.error).subspan(first, count);
+
+  for (const auto& term : terms)
+    {
+      const auto coefficient = static_cast<double>(term.coefficient);
+
+      if (!term.relative)
+        {
+          const auto in_chart = term.Z >= 0 && term.N >= 0 && term.Z <= Zmax && term.N <= Nmax;
+          constant += in_chart ? coefficient * mass_excess[slot(term.Z, term.N)] : missing;
+          constant_variance += in_chart ? coefficient * coefficient * variance[slot(term.Z, term.N)] : missing;
+          continue;
+        }
+
+      if (std::abs(term.Z) > REACH || std::abs(term.N) > REACH)
+        {
+          return std::nullopt;
+        }
+
+      // The border means the shifted range is always inside the grid
+      const auto shift = static_cast<std::ptrdiff_t>(term.Z) * static_cast<std::ptrdiff_t>(width) + term.N;
+      const auto from  = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(first) + shift);
+      const auto mass  = std::span<const double>(mass_excess).subspan(from, count);
+      const auto var   = std::span<const double>(variance).subspan(from, count);
+
+      const auto squared = coefficient * coefficient;
+      for (std::size_t i = 0; i < count; ++i)
+        {
+          value[i] += coefficient * mass[i];
+          error[i] += squared * var[i];
+        }
+    }
+
+  for (std::size_t i = 0; i < count; ++i)
+    {
+      value[i] += constant;
+      error[i] = std::sqrt(error[i] + constant_variance);
+    }
+
+  return column;
+}
+
+
+std::optional<DerivedQuantities::Column> DerivedQuantities::calculate(const Indicator indicator) const
+{
+  // Only differences are taken, so the masses of the free nucleons cancel and the binding energy can be replaced by
+  // the mass excess with the opposite sign
+  const auto stencil = [this](const std::vector<Term>& terms,
+                              const std::array<double, 4>& factors) -> std::optional<Column> {
+    const auto column = calculate(terms);
+    if (!column)
+      {
+        return std::nullopt;
+      }
+    const auto* const all = &column.value();
+    return combine({ all, all, all, all }, factors);
+  };
+
+  constexpr std::array<double, 4> alternate_N{ 0.5, -0.5, 0.5, -0.5 };
+  constexpr std::array<double, 4> alternate_Z{ 0.5, 0.5, -0.5, -0.5 };
+  constexpr std::array<double, 4> one{ 1.0, 1.0, 1.0, 1.0 };
+
+  switch (indicator)
+    {
+      case Indicator::PAIRING_GAP_3N:
+        return stencil({ { 0, -1, 1 }, { 0, 0, -2 }, { 0, 1, 1 } }, alternate_N);
+      case Indicator::PAIRING_GAP_3P:
+        return stencil({ { -1, 0, 1 }, { 0, 0, -2 }, { 1, 0, 1 } }, alternate_Z);
+      case Indicator::PAIRING_GAP_5N:
+        return stencil({ { 0, -2, -1 }, { 0, -1, 4 }, { 0, 0, -6 }, { 0, 1, 4 }, { 0, 2, -1 } },
+                       { 0.125, -0.125, 0.125, -0.125 });
+      case Indicator::PAIRING_GAP_5P:
+        return stencil({ { -2, 0, -1 }, { -1, 0, 4 }, { 0, 0, -6 }, { 1, 0, 4 }, { 2, 0, -1 } },
+                       { 0.125, 0.125, -0.125, -0.125 });
+      case Indicator::SHELL_GAP_2N:
+        return stencil({ { 0, -2, 1 }, { 0, 0, -2 }, { 0, 2, 1 } }, one);
+      case Indicator::SHELL_GAP_2P:
+        return stencil({ { -2, 0, 1 }, { 0, 0, -2 }, { 2, 0, 1 } }, one);
+      case Indicator::S2N_DERIVATIVE:
+        return stencil({ { 0, -4, -1 }, { 0, -2, 1 }, { 0, 0, 1 }, { 0, 2, -1 } }, { 0.25, 0.25, 0.25, 0.25 });
+      case Indicator::DELTA_VPN:
+      default:
+        break;
+    }
+
+  if (mass_excess.empty())
+    {
+      return std::nullopt;
+    }
+
+  // The step in Z or N is 2 when it is even and 1 when it is odd, so the stencil changes with the parity. Each row is
+  // swept once for the even and once for the odd N, straight into the result, as this is done for every table read.
+  Column column;
+  column.value.assign(mass_excess.size(), missing);
+  column.error.assign(mass_excess.size(), missing);
+
+  for (int Z = 0; Z <= Zmax; ++Z)
+    {
+      for (int odd_N = 0; odd_N < 2; ++odd_N)
+        {
+          const auto dZ     = (Z % 2 == 0) ? std::size_t{ 2 } : std::size_t{ 1 };
+          const auto dN     = (odd_N == 0) ? std::size_t{ 2 } : std::size_t{ 1 };
+          const auto scale  = 1.0 / static_cast<double>(dZ * dN);
+          const auto across = dZ * width;
+
+          for (auto position = slot(Z, odd_N); position <= slot(Z, Nmax); position += 2)
+            {
+              column.value[position] = scale
+                                       * (mass_excess[position - dN] + mass_excess[position - across]
+                                          - mass_excess[position] - mass_excess[position - across - dN]);
+              column.error[position] = scale
+                                       * std::sqrt(variance[position] + variance[position - dN]
+                                                   + variance[position - across] + variance[position - across - dN]);
+            }
+        }
+    }
+
+  return column;
+}
+
+
+DerivedQuantities::Column DerivedQuantities::combine(const std::array<const Column*, 4>& columns,
+                                                     const std::array<double, 4>& factors) const
+{
+  Column combined;
+  combined.value.assign(mass_excess.size(), missing);
+  combined.error.assign(mass_excess.size(), missing);
+
+  // Each row is swept twice, once for the even and once for the odd N, so the choice is made outside of the loop
+  for (int Z = 0; Z <= Zmax; ++Z)
+    {
+      for (int odd_N = 0; odd_N < 2; ++odd_N)
+        {
+          const auto index  = static_cast<std::size_t>(2 * (Z % 2) + odd_N);
+          const auto& from  = *columns.at(index);
+          const auto factor = factors.at(index);
+          const auto scale  = std::fabs(factor);
+
+          for (auto position = slot(Z, odd_N); position <= slot(Z, Nmax); position += 2)
+            {
+              combined.value[position] = factor * from.value[position];
+              combined.error[position] = scale * from.error[position];
+            }
+        }
+    }
+
+  return combined;
+}
+
+
+std::optional<Number> DerivedQuantities::at(const Column& column, const uint16_t Z, const uint16_t N) const
+{
+  if (Z > Zmax || N > Nmax || column.value.size() != mass_excess.size() || column.error.size() != mass_excess.size())
+    {
+      return std::nullopt;
+    }
+
+  const auto position = slot(Z, N);
+  if (std::isnan(column.value[position]))
+    {
+      return std::nullopt;
+    }
+
+  return Number{ column.value[position], column.error[position] };
+}
+
+
+std::vector<DerivedQuantities::Mismatch>
+DerivedQuantities::crossCheck(const MassTable& table, const Quantity quantity, const double sigmas) const
+{
+  std::vector<Mismatch> mismatches;
+
+  const auto column = calculate(quantity);
+  if (!column)
+    {
+      return mismatches;
+    }
+
+  if (isReactionQuantity(quantity))
+    {
+      table.readDeferredReactions();
+    }
+
+  // The files give values to 2 or 3 decimal places, allow for the rounding of each of them
+  constexpr double rounding{ 0.02 };
+
+  for (const auto& isotope : table.fullDataTable)
+    {
+      const auto tabulated = isotope.getQuantity(quantity);
+      if (Number::isMissing(tabulated.amount) || !tabulated.uncertainty || Number::isMissing(tabulated.uncertainty.value()))
+        {
+          continue;
+        }
+
+      const auto derived = at(column.value(), isotope.ame.Z, isotope.ame.N);
+      if (!derived)
+        {
+          continue;
+        }
+
+      const auto allowed = sigmas * std::hypot(derived->uncertainty.value_or(0.0), tabulated.uncertainty.value());
+      if (std::fabs(derived->amount - tabulated.amount) > allowed + rounding)
+        {
+          mismatches.push_back({ isotope.ame.A, isotope.ame.Z, derived.value(), tabulated });
+        }
+    }
+
+  return mismatches;
+}
@@ -0,0 +1,26 @@
+#include "nuclear-data-reader/diagnostics.hpp"
+
+#include <fmt/core.h>
+
+#include <cstdio>
+
+
+void ConsoleSink::report(const Diagnostic& diagnostic)
+{
+  if (diagnostic.severity == Severity::INFO)
+    {
+      fmt::print("{}", diagnostic.message);
+      return;
+    }
+
+  // Anything already on stdout, e.g. the name of the file being read, is printed first so the two stay in order
+  std::fflush(stdout);
+  fmt::print(stderr, "{}", diagnostic.message);
+}
+
+
+ConsoleSink& ConsoleSink::instance()
+{
+  static ConsoleSink console;
+  return console;
+}
@@ -2,11 +2,75 @@
 
 #include "nuclear-data-reader/converter.hpp"
 #include "nuclear-data-reader/nubase_data.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
 
 #include <fmt/core.h>
 
 #include <string>
 
+
+namespace
+{
+  /**
+   * Write a half life in scientific notation, or as null if it is not known
+   *
+   * \param The half life in seconds
+   *
+   * \return The half life as a string
+   */
+  [[nodiscard]] std::string writeHalfLife(const double seconds)
+  {
+    return Number::isMissing(seconds) ? std::string("null") : fmt::format("{:.3e}", seconds);
+  }
+} // namespace
+
+
+Number Isotope::getQuantity(const Quantity quantity) const
+{
+  switch (quantity)
+    {
+      case Quantity::AME_MASS_EXCESS:
+        return ame.mass_excess;
+      case Quantity::NUBASE_MASS_EXCESS:
+        return nubase.mass_excess;
+      case Quantity::BINDING_ENERGY_PER_A:
+        return ame.binding_energy_per_A;
+      case Quantity::BETA_DECAY_ENERGY:
+        return ame.beta_decay_energy;
+      case Quantity::ATOMIC_MASS:
+        return ame.atomic_mass;
+      case Quantity::S_N:
+        return ame.s_n;
+      case Quantity::S_P:
+        return ame.s_p;
+      case Quantity::S_2N:
+        return ame.s_2n;
+      case Quantity::S_2P:
+        return ame.s_2p;
+      case Quantity::Q_ALPHA:
+        return ame.q_a;
+      case Quantity::Q_2BM:
+        return ame.q_2bm;
+      case Quantity::Q_EP:
+        return ame.q_ep;
+      case Quantity::Q_BM_N:
+        return ame.q_bm_n;
+      case Quantity::Q_4BM:
+        return ame.q_4bm;
+      case Quantity::Q_DA:
+        return ame.q_da;
+      case Quantity::Q_PA:
+        return ame.q_pa;
+      case Quantity::Q_NA:
+        return ame.q_na;
+      case Quantity::HALF_LIFE:
+      default:
+        return Number{ nubase.hl.count(), nubase.hl_error.count() };
+    }
+}
+
+
 std::string Isotope::writeAsCSV() const
 {
   // One item per line as I find it simpler to use
@@ -20,7 +84,7 @@ std::string Isotope::writeAsCSV() const
                      "{7},"
                      "{8},"
                      "{9},"
-                     "{10:.3e},"
+                     "{10},"
                      "{11},"
                      "{12},"
                      "{13},"
@@ -55,14 +119,14 @@ std::string Isotope::writeAsCSV() const
                      ame.A,
                      ame.Z,
                      ame.N,
-                     nubase.symbol,
-                     nubase.decay,
+                     nubase.symbol.str(),
+                     nubase.decay.str(),
                      (nubase.exp == NUBASE::Measured::EXPERIMENTAL) ? 0 : 1,
                      Converter::FloatToNdp(nubase.mass_excess.amount, NDP),
                      Converter::FloatToNdp(nubase.mass_excess.uncertainty.value_or(-1.0), NDP),
                      Converter::FloatToNdp(ame.mass_excess.amount, NDP),
                      Converter::FloatToNdp(ame.mass_excess.uncertainty.value_or(-1.0), NDP),
-                     nubase.hl.count(),
+                     writeHalfLife(nubase.hl.count()),
                      Converter::FloatToNdp(ame.s_n.amount, NDP),
                      Converter::FloatToNdp(ame.s_n.uncertainty.value_or(-1.0), NDP),
                      Converter::FloatToNdp(ame.s_p.amount, NDP),
@@ -109,7 +173,7 @@ std::string Isotope::writeAsJSON(const bool human_readable) const
                      "\"ErrorNubaseMassExcess\":{8},{0}"
                      "\"AMEMassExcess\":{9},{0}"
                      "\"ErrorAMEMassExcess\":{10},{0}"
-                     "\"HalfLife\":{11:.3e},{0}"
+                     "\"HalfLife\":{11},{0}"
                      "\"SingleNeutronSeparationEnergy\":{12},{0}"
                      "\"ErrorSingleNeutronSeparationEnergy\":{13},{0}"
                      "\"SingleProtonSeparationEnergy\":{14},{0}"
@@ -146,14 +210,14 @@ std::string Isotope::writeAsJSON(const bool human_readable) const
                      ame.A,
                      ame.Z,
                      ame.N,
-                     nubase.symbol,
-                     nubase.decay,
+                     nubase.symbol.str(),
+                     nubase.decay.str(),
                      (nubase.exp == NUBASE::Measured::EXPERIMENTAL) ? 0 : 1,
                      Converter::FloatToNdp(nubase.mass_excess.amount, NDP),
                      Converter::FloatToNdp(nubase.mass_excess.uncertainty.value_or(-1.0), NDP),
                      Converter::FloatToNdp(ame.mass_excess.amount, NDP),
                      Converter::FloatToNdp(ame.mass_excess.uncertainty.value_or(-1.0), NDP),
-                     nubase.hl.count(),
+                     writeHalfLife(nubase.hl.count()),
                      Converter::FloatToNdp(ame.s_n.amount, NDP),
                      Converter::FloatToNdp(ame.s_n.uncertainty.value_or(-1.0), NDP),
                      Converter::FloatToNdp(ame.s_p.amount, NDP),
@@ -1,9 +1,19 @@
 #include "nuclear-data-reader/massTable.hpp"
 
 #include "nuclear-data-reader/ame_data.hpp"
+#include "nuclear-data-reader/chart_index.hpp"
 #include "nuclear-data-reader/converter.hpp"
+#include "nuclear-data-reader/derived_quantities.hpp"
+#include "nuclear-data-reader/diagnostics.hpp"
+#include "nuclear-data-reader/field_mask.hpp"
 #include "nuclear-data-reader/isotope.hpp"
+#include "nuclear-data-reader/load_stats.hpp"
 #include "nuclear-data-reader/nubase_data.hpp"
+#include "nuclear-data-reader/nubase_decay_mode.hpp"
+#include "nuclear-data-reader/nubase_isomer_table.hpp"
+#include "nuclear-data-reader/nuclide_key.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
 
 #include <fmt/core.h>
 #include <fmt/format.h>
@@ -12,13 +22,21 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <ios>
 #include <iterator>
 #include <limits>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 void MassTable::setFilePaths() const
@@ -85,6 +103,10 @@ void MassTable::setFilePaths() const
 
 bool MassTable::populateInternalMassTable()
 {
+  load_stats = LoadStats{};
+  // Anything deferred by a previous load has either been done or is no longer wanted
+  reaction_load = LoadOnce{};
+
   setFilePaths();
 
   // There is always AME data
@@ -95,16 +117,27 @@ bool MassTable::populateInternalMassTable()
     {
       if (readNUBASE(NUBASE_masstable))
         {
-          return mergeData();
+          const auto merged = mergeData();
+          buildIndex();
+          return merged;
         }
-      fmt::print("NUBASE data has not been read\n");
+      diagnostics.report({ Severity::WARNING, DiagnosticCode::NOT_READ, &NUBASE_masstable },
+                         []() { return std::string("NUBASE data has not been read\n"); });
     }
 
-  const auto nubase_data = NUBASE::Data("", LAST_YEAR_AME_ONLY);
-  for (const auto& ame : ameDataTable)
-    {
-      fullDataTable.emplace_back(ame, nubase_data);
-    }
+  {
+    auto& stats = load_stats[LoadPhase::MERGE];
+    const LoadStats::Timer timer(stats, allocation_probe);
+
+    const auto nubase_data = NUBASE::Data("", LAST_YEAR_AME_ONLY);
+    for (const auto& ame : ameDataTable)
+      {
+        fullDataTable.emplace_back(ame, nubase_data);
+      }
+    stats.records += static_cast<uint32_t>(ameDataTable.size());
+  }
+
+  buildIndex();
 
   return true;
 }
@@ -114,23 +147,369 @@ bool MassTable::readAME() const
 {
   if (!readAMEMassFile(AME_masstable))
     {
-      fmt::print("Values from AME were not read.\n");
+      diagnostics.report({ Severity::WARNING, DiagnosticCode::NOT_READ, &AME_masstable },
+                         []() { return std::string("Values from AME were not read.\n"); });
     }
 
-  if (!readAMEReactionFileOne(AME_reaction_1))
+  // Don't bother with the reaction files if none of the values in them are wanted
+  if (!fields.wantsReactionOne() && !fields.wantsReactionTwo())
     {
-      fmt::print("Reaction values from first AME file not read.\n");
+      return true;
     }
 
-  if (!readAMEReactionFileTwo(AME_reaction_2))
+  // Only register the files, they will be read the first time a reaction value is asked for
+  if (load_mode == LoadMode::LAZY_REACTIONS)
     {
-      fmt::print("Reaction values from second AME file not read.\n");
+      reaction_load.pending.store(true, std::memory_order_release);
+      return true;
     }
 
+  readAMEReactionFiles();
+
   return true;
 }
 
 
+bool MassTable::readAMEReactionFiles() const
+{
+  bool success{ true };
+
+  if (fields.wantsReactionOne() && !readAMEReactionFileOne(AME_reaction_1))
+    {
+      diagnostics.report({ Severity::WARNING, DiagnosticCode::NOT_READ, &AME_reaction_1 },
+                         []() { return std::string("Reaction values from first AME file not read.\n"); });
+      success = false;
+    }
+
+  if (fields.wantsReactionTwo() && !readAMEReactionFileTwo(AME_reaction_2))
+    {
+      diagnostics.report({ Severity::WARNING, DiagnosticCode::NOT_READ, &AME_reaction_2 },
+                         []() { return std::string("Reaction values from second AME file not read.\n"); });
+      success = false;
+    }
+
+  return success;
+}
+
+
+bool MassTable::readDeferredReactions() const
+{
+  if (!reaction_load.pending.load(std::memory_order_acquire))
+    {
+      return reaction_load.succeeded.load(std::memory_order_acquire);
+    }
+
+  std::call_once(*reaction_load.flag, [this]() {
+    reaction_load.succeeded.store(readAMEReactionFiles(), std::memory_order_release);
+    updateMergedReactionData();
+    reaction_load.pending.store(false, std::memory_order_release);
+  });
+
+  return reaction_load.succeeded.load(std::memory_order_acquire);
+}
+
+
+void MassTable::updateMergedReactionData() const
+{
+  // The merged table is a copy of the AME data so needs updating now the reaction values have been read
+  if (ame_index.size() != ameDataTable.size())
+    {
+      indexAME();
+    }
+
+  // Older tables include some isomers so the same A and Z can appear more than once.
+  // Keep track of which entries have been used so the n-th isotope is updated with the n-th AME entry
+  std::vector<bool> used(ame_index.size(), false);
+
+  for (auto& isotope : fullDataTable)
+    {
+      const auto key = isotope.ame.key();
+
+      auto ame = std::lower_bound(ame_index.cbegin(), ame_index.cend(), std::pair{ key, uint32_t{ 0 } });
+      while (ame != ame_index.cend() && ame->first == key && used[static_cast<std::size_t>(ame - ame_index.cbegin())])
+        {
+          ++ame;
+        }
+
+      if (ame != ame_index.cend() && ame->first == key)
+        {
+          used[static_cast<std::size_t>(ame - ame_index.cbegin())] = true;
+          // Readers may be using the rest of the isotope, so only the reaction values are written
+          isotope.ame.setReactionValues(ameDataTable[ame->second]);
+        }
+    }
+}
+
+
+namespace
+{
+  /**
+   * Index a table by the key of each entry
+   *
+   * \param The table
+   * \param Filled with the key and position of every entry, sorted by key then position
+   *
+   * \return Nothing
+   */
+  template<typename Data>
+  void indexByKey(const std::vector<Data>& table, std::vector<std::pair<NuclideKey, uint32_t>>& index)
+  {
+    index.clear();
+    index.reserve(table.size());
+    for (uint32_t position = 0; position < table.size(); ++position)
+      {
+        index.emplace_back(table[position].key(), position);
+      }
+
+    // The files are already in key order, so this is normally just a check
+    if (!std::is_sorted(index.cbegin(), index.cend()))
+      {
+        std::sort(index.begin(), index.end());
+      }
+  }
+
+  /**
+   * Find the first entry of an index with the given key, or where it would be if it is not there
+   *
+   * \param The index
+   * \param The key
+   *
+   * \return An iterator to the entry
+   */
+  [[nodiscard]] inline auto lowerBound(const std::vector<std::pair<NuclideKey, uint32_t>>& index, const NuclideKey key)
+  {
+    // The position is part of the sort, so the first entry with the key is the one that was read first
+    return std::lower_bound(index.cbegin(), index.cend(), std::pair{ key, uint32_t{ 0 } });
+  }
+} // namespace
+
+
+void MassTable::indexAME() const
+{
+  indexByKey(ameDataTable, ame_index);
+}
+
+
+void MassTable::indexNUBASE() const
+{
+  indexByKey(nubaseDataTable, nubase_index);
+}
+
+
+void MassTable::setDeltaVpn() const
+{
+  const DerivedQuantities derived(*this);
+  const auto column = derived.calculate(DerivedQuantities::Indicator::DELTA_VPN);
+
+  // Older tables list some isomers straight after the ground state, they are not given a value
+  const AME::Data* previous{ nullptr };
+  for (const auto& ame : ameDataTable)
+    {
+      if (previous == nullptr || previous->key() != ame.key())
+        {
+          const auto value = column ? derived.at(column.value(), ame.Z, ame.N) : std::nullopt;
+          ame.dV_pn        = value.value_or(Number{ Number::MISSING });
+        }
+      previous = &ame;
+    }
+}
+
+
+std::vector<AME::Data>::iterator MassTable::findAME(const NuclideKey key) const
+{
+  if (ame_index.size() != ameDataTable.size())
+    {
+      indexAME();
+    }
+
+  // Entries can be changed after the index was built. Check the entries either side of where the key is, or would
+  // be, still have the keys they were indexed with, and rebuild the index if not.
+  const auto current = [this](const auto entry) { return ameDataTable[entry->second].key() == entry->first; };
+
+  auto found = lowerBound(ame_index, key);
+  if ((found != ame_index.cend() && !current(found)) || (found != ame_index.cbegin() && !current(std::prev(found))))
+    {
+      indexAME();
+      found = lowerBound(ame_index, key);
+    }
+
+  return (found != ame_index.cend() && found->first == key)
+             ? std::next(ameDataTable.begin(), static_cast<std::ptrdiff_t>(found->second))
+             : ameDataTable.end();
+}
+
+
+namespace
+{
+  /**
+   * Ask for memory to be brought into cache ahead of it being used. Does nothing if the compiler can't do this.
+   *
+   * \param The address that will be used
+   *
+   * \return Nothing
+   */
+  template<int WRITE = 0>
+  inline void prefetch([[maybe_unused]] const void* address) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, WRITE);
+#endif
+  }
+} // namespace
+
+
+std::vector<const Isotope*>
+MassTable::getRegion(const uint16_t Zmin, const uint16_t Zmax, const uint16_t Nmin, const uint16_t Nmax) const
+{
+  std::vector<const Isotope*> isotopes;
+
+  const auto positions = chart_index.region(Zmin, Zmax, Nmin, Nmax);
+  isotopes.reserve(positions.size());
+  for (const auto position : positions)
+    {
+      isotopes.push_back(&fullDataTable[position]);
+    }
+
+  return isotopes;
+}
+
+
+std::size_t MassTable::lookupMany(std::span<const NuclideKey> keys, std::span<const Isotope*> results) const
+{
+  // How many keys ahead the slot of the grid is fetched. The isotope, and the slot of its result, are fetched half as
+  // far ahead, by which time the slot of the grid has arrived.
+  constexpr std::size_t AHEAD{ 16 };
+
+  const auto count = std::min(keys.size(), results.size());
+  const auto& grid = chart_index.grid;
+
+  std::size_t found{ 0 };
+  for (std::size_t i = 0; i < count; ++i)
+    {
+      if (i + AHEAD < count)
+        {
+          const auto slot = chart_index.gridSlot(keys[i + AHEAD].Z(), keys[i + AHEAD].N());
+          prefetch(grid.data() + slot);
+        }
+
+      if (i + AHEAD / 2 < count)
+        {
+          const auto& key = keys[i + AHEAD / 2];
+          if (const auto position = chart_index.position(key.Z(), key.N()); position != ChartIndex::NO_ISOTOPE)
+            {
+              prefetch(&fullDataTable[position]);
+            }
+          prefetch<1>(&results[i + AHEAD / 2]);
+        }
+
+      const auto position = chart_index.position(keys[i].Z(), keys[i].N());
+      results[i]          = (position != ChartIndex::NO_ISOTOPE) ? &fullDataTable[position] : nullptr;
+      found += (position != ChartIndex::NO_ISOTOPE) ? 1 : 0;
+    }
+
+  return found;
+}
+
+
+std::optional<Number> MassTable::getQuantity(const uint16_t A, const uint16_t Z, const Quantity quantity) const
+{
+  if (!fields.wants(quantity))
+    {
+      return std::nullopt;
+    }
+
+  if (isReactionQuantity(quantity))
+    {
+      readDeferredReactions();
+    }
+
+  const auto position = (A >= Z) ? chart_index.position(Z, static_cast<uint16_t>(A - Z)) : ChartIndex::NO_ISOTOPE;
+  if (position == ChartIndex::NO_ISOTOPE || position >= fullDataTable.size())
+    {
+      return std::nullopt;
+    }
+
+  return fullDataTable[position].getQuantity(quantity);
+}
+
+
+std::span<const NUBASE::DecayBranch> MassTable::getDecayBranches(const uint16_t A, const uint16_t Z) const
+{
+  if (nubase_index.size() != nubaseDataTable.size())
+    {
+      indexNUBASE();
+    }
+
+  const NuclideKey wanted{ A, Z };
+  const auto found = lowerBound(nubase_index, wanted);
+
+  return (found != nubase_index.cend() && found->first == wanted) ? decay_branches.branchesOf(found->second)
+                                                                   : std::span<const NUBASE::DecayBranch>{};
+}
+
+
+namespace
+{
+  /**
+   * Mark the values of an isotope that are not going to be parsed as missing. They would otherwise be left as zero,
+   * which can't be told apart from a measurement. Reaction values are included as the files may not be read at all.
+   *
+   * \param The isotope, as it is created from the mass file
+   * \param Which values are going to be parsed
+   *
+   * \return Nothing
+   */
+  void markUnparsed(const AME::Data& data, const FieldMask& fields)
+  {
+    const auto mark = [&fields](const Quantity quantity, Number& number) {
+      if (!fields.wants(quantity))
+        {
+          number = Number{ Number::MISSING, Number::MISSING };
+        }
+    };
+
+    mark(Quantity::AME_MASS_EXCESS, data.mass_excess);
+    mark(Quantity::BINDING_ENERGY_PER_A, data.binding_energy_per_A);
+    mark(Quantity::BETA_DECAY_ENERGY, data.beta_decay_energy);
+    mark(Quantity::ATOMIC_MASS, data.atomic_mass);
+    mark(Quantity::S_N, data.s_n);
+    mark(Quantity::S_P, data.s_p);
+    mark(Quantity::S_2N, data.s_2n);
+    mark(Quantity::S_2P, data.s_2p);
+    mark(Quantity::Q_ALPHA, data.q_a);
+    mark(Quantity::Q_2BM, data.q_2bm);
+    mark(Quantity::Q_EP, data.q_ep);
+    mark(Quantity::Q_BM_N, data.q_bm_n);
+    mark(Quantity::Q_4BM, data.q_4bm);
+    mark(Quantity::Q_DA, data.q_da);
+    mark(Quantity::Q_PA, data.q_pa);
+    mark(Quantity::Q_NA, data.q_na);
+  }
+
+  /**
+   * Mark the values of a ground state that are not going to be parsed as missing, so they aren't mistaken for zero
+   *
+   * \param The ground state
+   * \param Which values are going to be parsed
+   *
+   * \return Nothing
+   */
+  void markUnparsed(const NUBASE::Data& data, const FieldMask& fields)
+  {
+    if (!fields.wants(Quantity::NUBASE_MASS_EXCESS))
+      {
+        data.mass_excess = Number{ Number::MISSING, Number::MISSING };
+      }
+
+    if (!fields.wants(Quantity::HALF_LIFE))
+      {
+        data.hl       = std::chrono::duration<double>{ Number::MISSING };
+        data.hl_error = std::chrono::duration<double>{ Number::MISSING };
+      }
+  }
+} // namespace
+
+
 AME::Data MassTable::parseAMEMassFormat(const std::string& line) const
 {
   AME::Data data(line, year);
@@ -139,17 +518,31 @@ AME::Data MassTable::parseAMEMassFormat(const std::string& line) const
   data.setN();
   data.setA(year);
 
-  data.setMassExcess();
-  data.setMassExcessError();
+  markUnparsed(data, fields);
+
+  if (fields.wants(Quantity::AME_MASS_EXCESS))
+    {
+      data.setMassExcess();
+      data.setMassExcessError();
+    }
 
-  data.setBindingEnergyPerA();
-  data.setBindingEnergyPerAError();
+  if (fields.wants(Quantity::BINDING_ENERGY_PER_A))
+    {
+      data.setBindingEnergyPerA();
+      data.setBindingEnergyPerAError();
+    }
 
-  data.setBetaDecayEnergy();
-  data.setBetaDecayEnergyError();
+  if (fields.wants(Quantity::BETA_DECAY_ENERGY))
+    {
+      data.setBetaDecayEnergy();
+      data.setBetaDecayEnergyError();
+    }
 
-  data.setAtomicMass();
-  data.setAtomicMassError();
+  if (fields.wants(Quantity::ATOMIC_MASS))
+    {
+      data.setAtomicMass();
+      data.setAtomicMassError();
+    }
 
   return data;
 }
@@ -161,19 +554,21 @@ MassTable::getMatchingIsotope(const std::string& line, const uint16_t table_A, c
   // Check that the mass table has already been populated
   if (ameDataTable.empty())
     {
-      fmt::print("Mass table must be read first\n");
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::OUT_OF_ORDER },
+                         []() { return std::string("Mass table must be read first\n"); });
       return ameDataTable.end();
     }
 
   // Look for the correct isotope in the existing data table
-  auto isotope = std::find_if(ameDataTable.begin(), ameDataTable.end(), [table_A, table_Z](const auto& ame) -> bool {
-    return (ame.A == table_A && ame.Z == table_Z);
-  });
+  auto isotope = findAME({ table_A, table_Z });
 
   // Get out if it doesn't exist
   if (isotope == ameDataTable.end())
     {
-      fmt::print("**WARNING**: No matching mass data found for A={}, Z={}\n", table_A, table_Z);
+      diagnostics.report({ Severity::WARNING, DiagnosticCode::NO_MATCHING_MASS_DATA, nullptr, 0, table_A, table_Z },
+                         [table_A, table_Z]() {
+                           return fmt::format("**WARNING**: No matching mass data found for A={}, Z={}\n", table_A, table_Z);
+                         });
       return ameDataTable.end();
     }
 
@@ -197,23 +592,41 @@ bool MassTable::parseAMEReactionTwoFormat(const std::string& line, const uint16_
       return false;
     }
 
-  isotope->setOneNeutronSeparationEnergy();
-  isotope->setOneNeutronSeparationEnergyError();
+  if (fields.wants(Quantity::S_N))
+    {
+      isotope->setOneNeutronSeparationEnergy();
+      isotope->setOneNeutronSeparationEnergyError();
+    }
 
-  isotope->setOneProtonSeparationEnergy();
-  isotope->setOneProtonSeparationEnergyError();
+  if (fields.wants(Quantity::S_P))
+    {
+      isotope->setOneProtonSeparationEnergy();
+      isotope->setOneProtonSeparationEnergyError();
+    }
 
-  isotope->setQQuadrupleBetaMinusEnergy();
-  isotope->setQQuadrupleBetaMinusEnergyError();
+  if (fields.wants(Quantity::Q_4BM))
+    {
+      isotope->setQQuadrupleBetaMinusEnergy();
+      isotope->setQQuadrupleBetaMinusEnergyError();
+    }
 
-  isotope->setQDAlphaEnergy();
-  isotope->setQDAlphaEnergyError();
+  if (fields.wants(Quantity::Q_DA))
+    {
+      isotope->setQDAlphaEnergy();
+      isotope->setQDAlphaEnergyError();
+    }
 
-  isotope->setQPAlphaEnergy();
-  isotope->setQPAlphaEnergyError();
+  if (fields.wants(Quantity::Q_PA))
+    {
+      isotope->setQPAlphaEnergy();
+      isotope->setQPAlphaEnergyError();
+    }
 
-  isotope->setQNAlphaEnergy();
-  isotope->setQNAlphaEnergyError();
+  if (fields.wants(Quantity::Q_NA))
+    {
+      isotope->setQNAlphaEnergy();
+      isotope->setQNAlphaEnergyError();
+    }
 
   return true;
 }
@@ -228,23 +641,41 @@ bool MassTable::parseAMEReactionOneFormat(const std::string& line, const uint16_
       return false;
     }
 
-  isotope->setTwoNeutronSeparationEnergy();
-  isotope->setTwoNeutronSeparationEnergyError();
+  if (fields.wants(Quantity::S_2N))
+    {
+      isotope->setTwoNeutronSeparationEnergy();
+      isotope->setTwoNeutronSeparationEnergyError();
+    }
 
-  isotope->setTwoProtonSeparationEnergy();
-  isotope->setTwoProtonSeparationEnergyError();
+  if (fields.wants(Quantity::S_2P))
+    {
+      isotope->setTwoProtonSeparationEnergy();
+      isotope->setTwoProtonSeparationEnergyError();
+    }
 
-  isotope->setQAlphaEnergy();
-  isotope->setQAlphaEnergyError();
+  if (fields.wants(Quantity::Q_ALPHA))
+    {
+      isotope->setQAlphaEnergy();
+      isotope->setQAlphaEnergyError();
+    }
 
-  isotope->setQDoubleBetaMinusEnergy();
-  isotope->setQDoubleBetaMinusEnergyError();
+  if (fields.wants(Quantity::Q_2BM))
+    {
+      isotope->setQDoubleBetaMinusEnergy();
+      isotope->setQDoubleBetaMinusEnergyError();
+    }
 
-  isotope->setQEpsilonPEnergy();
-  isotope->setQEpsilonPEnergyError();
+  if (fields.wants(Quantity::Q_EP))
+    {
+      isotope->setQEpsilonPEnergy();
+      isotope->setQEpsilonPEnergyError();
+    }
 
-  isotope->setQBetaMinusNEnergy();
-  isotope->setQBetaMinusNEnergyError();
+  if (fields.wants(Quantity::Q_BM_N))
+    {
+      isotope->setQBetaMinusNEnergy();
+      isotope->setQBetaMinusNEnergyError();
+    }
 
   return true;
 }
@@ -252,11 +683,16 @@ bool MassTable::parseAMEReactionOneFormat(const std::string& line, const uint16_
 
 bool MassTable::readAMEMassFile(const std::filesystem::path& ameTable) const
 {
-  fmt::print("Reading {} for AME mass excess values <--", ameTable);
+  auto& stats = load_stats[LoadPhase::AME_MASS];
+  const LoadStats::Timer timer(stats, allocation_probe);
+
+  diagnostics.report({ Severity::INFO, DiagnosticCode::PROGRESS, &ameTable },
+                     [&ameTable]() { return fmt::format("Reading {} for AME mass excess values <--", ameTable); });
 
   if (!std::filesystem::exists(ameTable))
     {
-      fmt::print("\n***ERROR***: {} does not exist?\n\n", ameTable);
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::FILE_NOT_FOUND, &ameTable },
+                         [&ameTable]() { return fmt::format("\n***ERROR***: {} does not exist?\n\n", ameTable); });
       return false;
     }
 
@@ -267,34 +703,52 @@ bool MassTable::readAMEMassFile(const std::filesystem::path& ameTable) const
   for (line_number = 0; line_number < data.mass_position.HEADER; ++line_number)
     {
       file.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+      stats.addLine(static_cast<std::size_t>(file.gcount()));
+      ++stats.lines_skipped;
     }
 
   std::string line;
   while (std::getline(file, line) && line_number < data.mass_position.FOOTER)
     {
       ++line_number;
+      stats.addLine(line.size() + 1);
       // skip repeated header
       if (year == uint16_t{ 1983 }
           && (line.find("MASS EXCESS") != std::string::npos || line.find("(keV)") != std::string::npos))
         {
+          ++stats.lines_skipped;
           continue;
         }
 
       ameDataTable.emplace_back(parseAMEMassFormat(line));
+      ++stats.records;
+    }
+
+  indexAME();
+
+  // The interaction is calculated from the mass excesses, so can only be found if they were read
+  if (fields.wants(Quantity::AME_MASS_EXCESS))
+    {
+      setDeltaVpn();
     }
 
-  fmt::print("--> done\n");
+  diagnostics.report({ Severity::INFO, DiagnosticCode::PROGRESS }, []() { return std::string("--> done\n"); });
   return true;
 }
 
 
 bool MassTable::readAMEReactionFileOne(const std::filesystem::path& reactionFile) const
 {
-  fmt::print("Reading {} for reaction data <--", reactionFile);
+  auto& stats = load_stats[LoadPhase::AME_REACTION_1];
+  const LoadStats::Timer timer(stats, allocation_probe);
+
+  diagnostics.report({ Severity::INFO, DiagnosticCode::PROGRESS, &reactionFile },
+                     [&reactionFile]() { return fmt::format("Reading {} for reaction data <--", reactionFile); });
 
   if (!std::filesystem::exists(reactionFile))
     {
-      fmt::print("\n***ERROR***: {} does not exist?\n\n", reactionFile);
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::FILE_NOT_FOUND, &reactionFile },
+                         [&reactionFile]() { return fmt::format("\n***ERROR***: {} does not exist?\n\n", reactionFile); });
       return false;
     }
 
@@ -305,6 +759,8 @@ bool MassTable::readAMEReactionFileOne(const std::filesystem::path& reactionFile
   for (line_number = 0; line_number < data.r1_position.R1_HEADER; ++line_number)
     {
       file.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+      stats.addLine(static_cast<std::size_t>(file.gcount()));
+      ++stats.lines_skipped;
     }
 
   std::string line;
@@ -312,9 +768,11 @@ bool MassTable::readAMEReactionFileOne(const std::filesystem::path& reactionFile
   while (std::getline(file, line) && line_number < data.r1_position.R1_FOOTER)
     {
       ++line_number;
+      stats.addLine(line.size() + 1);
       // skip repeated header
       if (year == uint16_t{ 1983 } && (line.find("A  EL") != std::string::npos || line.starts_with("1")))
         {
+          ++stats.lines_skipped;
           continue;
         }
 
@@ -329,22 +787,34 @@ bool MassTable::readAMEReactionFileOne(const std::filesystem::path& reactionFile
       // std::cout << "Running: " << current_A << " | " << current_Z << std::endl;
       if (!parseAMEReactionOneFormat(line, current_A, current_Z))
         {
-          fmt::print("**WARNING**: No matching isotope found for\n{}\n", line);
+          diagnostics.report(
+              { Severity::WARNING, DiagnosticCode::NO_MATCHING_ISOTOPE, &reactionFile, line_number, current_A, current_Z },
+              [&line]() { return fmt::format("**WARNING**: No matching isotope found for\n{}\n", line); });
+          ++stats.unmatched;
+        }
+      else
+        {
+          ++stats.records;
         }
     }
 
-  fmt::print("--> done\n");
+  diagnostics.report({ Severity::INFO, DiagnosticCode::PROGRESS }, []() { return std::string("--> done\n"); });
   return true;
 }
 
 
 bool MassTable::readAMEReactionFileTwo(const std::filesystem::path& reactionFile) const
 {
-  fmt::print("Reading {} for reaction data <--", reactionFile);
+  auto& stats = load_stats[LoadPhase::AME_REACTION_2];
+  const LoadStats::Timer timer(stats, allocation_probe);
+
+  diagnostics.report({ Severity::INFO, DiagnosticCode::PROGRESS, &reactionFile },
+                     [&reactionFile]() { return fmt::format("Reading {} for reaction data <--", reactionFile); });
 
   if (!std::filesystem::exists(reactionFile))
     {
-      fmt::print("\n***ERROR***: {} does not exist?\n\n", reactionFile);
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::FILE_NOT_FOUND, &reactionFile },
+                         [&reactionFile]() { return fmt::format("\n***ERROR***: {} does not exist?\n\n", reactionFile); });
       return false;
     }
 
@@ -355,6 +825,8 @@ bool MassTable::readAMEReactionFileTwo(const std::filesystem::path& reactionFile
   for (line_number = 0; line_number < data.r2_position.R2_HEADER; ++line_number)
     {
       file.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+      stats.addLine(static_cast<std::size_t>(file.gcount()));
+      ++stats.lines_skipped;
     }
 
   std::string line;
@@ -362,15 +834,18 @@ bool MassTable::readAMEReactionFileTwo(const std::filesystem::path& reactionFile
   while (std::getline(file, line) && line_number < data.r2_position.R2_FOOTER)
     {
       ++line_number;
+      stats.addLine(line.size() + 1);
       // skip repeated header which only happens in the 2020 file (so far)
       if (year == uint16_t{ 1983 } && (line.find("A  EL") != std::string::npos || line.starts_with("1")))
         {
+          ++stats.lines_skipped;
           continue;
         }
 
       // skip repeated header which only happens in the 2020 file (so far)
       if (year == uint16_t{ 2020 } && line.find("1 A  elt") != std::string::npos)
         {
+          ++stats.lines_skipped;
           continue;
         }
 
@@ -383,11 +858,18 @@ bool MassTable::readAMEReactionFileTwo(const std::filesystem::path& reactionFile
 
       if (!parseAMEReactionTwoFormat(line, current_A, current_Z))
         {
-          fmt::print("**WARNING**: No matching isotope found for\n{}\n", line);
+          diagnostics.report(
+              { Severity::WARNING, DiagnosticCode::NO_MATCHING_ISOTOPE, &reactionFile, line_number, current_A, current_Z },
+              [&line]() { return fmt::format("**WARNING**: No matching isotope found for\n{}\n", line); });
+          ++stats.unmatched;
+        }
+      else
+        {
+          ++stats.records;
         }
     }
 
-  fmt::print("--> done\n");
+  diagnostics.report({ Severity::INFO, DiagnosticCode::PROGRESS }, []() { return std::string("--> done\n"); });
   return true;
 }
 
@@ -397,7 +879,10 @@ NUBASE::Data MassTable::parseNUBASEFormat(const std::string& line) const
 {
   NUBASE::Data data(line, year);
 
-  data.setSpinParity();
+  if (fields.wants(Property::SPIN_PARITY))
+    {
+      data.setSpinParity();
+    }
 
   data.setExperimental();
 
@@ -413,7 +898,7 @@ NUBASE::Data MassTable::parseNUBASEFormat(const std::string& line) const
   // Set the symbol as an obviously wrong value if an invalid Z was read
   else
     {
-      data.setSymbol("Xx");
+      data.symbol = NUBASE::invalid_symbol;
     }
 
   data.setState();
@@ -424,21 +909,38 @@ NUBASE::Data MassTable::parseNUBASEFormat(const std::string& line) const
       return data;
     }
 
-  data.setMassExcess();
-  data.setMassExcessError();
+  markUnparsed(data, fields);
 
-  data.setHalfLife();
+  if (fields.wants(Quantity::NUBASE_MASS_EXCESS))
+    {
+      data.setMassExcess();
+      data.setMassExcessError();
+    }
 
-  data.setYear();
+  if (fields.wants(Quantity::HALF_LIFE))
+    {
+      data.setHalfLife();
+    }
+
+  if (fields.wants(Property::DISCOVERY_YEAR))
+    {
+      data.setYear();
+    }
+
+  // The rich flag is defined relative to the stable isotopes so can only be set if we know the decay mode
+  if (!fields.wants(Property::DECAY_MODE))
+    {
+      return data;
+    }
 
   data.setDecayMode();
 
-  if (data.decay == "stable")
+  if (data.decay == NUBASE::DecayMode::common("stable"))
     {
       neutron_rich.at(data.Z) = true;
     }
 
-  if (data.symbol != "Xx")
+  if (data.symbol != NUBASE::invalid_symbol)
     {
       data.setNeutronOrProtonRich(neutron_rich.at(data.Z));
     }
@@ -449,11 +951,17 @@ NUBASE::Data MassTable::parseNUBASEFormat(const std::string& line) const
 
 bool MassTable::readNUBASE(const std::filesystem::path& nubaseTable)
 {
-  fmt::print("Reading {} for nuclear values <--", nubaseTable);
+  auto& stats = load_stats[LoadPhase::NUBASE];
+  const LoadStats::Timer timer(stats, allocation_probe);
+
+  diagnostics.report({ Severity::INFO, DiagnosticCode::PROGRESS, &nubaseTable },
+                     [&nubaseTable]() { return fmt::format("Reading {} for nuclear values <--", nubaseTable); });
 
   if (!std::filesystem::exists(nubaseTable))
     {
-      fmt::print("\n***ERROR***: {} couldn't be opened, does it exist?\n\n", nubaseTable);
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::FILE_NOT_FOUND, &nubaseTable }, [&nubaseTable]() {
+        return fmt::format("\n***ERROR***: {} couldn't be opened, does it exist?\n\n", nubaseTable);
+      });
       return false;
     }
 
@@ -464,6 +972,8 @@ bool MassTable::readNUBASE(const std::filesystem::path& nubaseTable)
   for (line_number = 0; line_number < data.position.HEADER; ++line_number)
     {
       file.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+      stats.addLine(static_cast<std::size_t>(file.gcount()));
+      ++stats.lines_skipped;
     }
 
   std::string line;
@@ -471,8 +981,10 @@ bool MassTable::readNUBASE(const std::filesystem::path& nubaseTable)
   while (std::getline(file, line) && line_number < data.position.FOOTER)
     {
       ++line_number;
+      stats.addLine(line.size() + 1);
       if (line.find("non-exist") != std::string::npos)
         {
+          ++stats.lines_skipped;
           continue;
         }
 
@@ -482,76 +994,219 @@ bool MassTable::readNUBASE(const std::filesystem::path& nubaseTable)
       // We don't want to add a new entry to the vector so skip that step
       if (nuclide.level != 0)
         {
-          nuclide.setIsomerData(nubaseDataTable);
+          if (nuclide.setIsomerData(nubaseDataTable, isomers))
+            {
+              ++load_stats.isomers_attached;
+            }
+          else
+            {
+              // Should never get here
+              diagnostics.report(
+                  { Severity::WARNING, DiagnosticCode::NO_GROUND_STATE, &nubaseTable, line_number, nuclide.A, nuclide.Z },
+                  []() { return std::string("**WARNING**: This isomer has no matching ground-state\n"); });
+              ++stats.unmatched;
+            }
           continue;
         }
 
+      // Split the decay string into its branches while we have the line, keeping a row for every isotope
+      if (fields.wants(Property::DECAY_MODE))
+        {
+          decay_branches.addIsotope(nuclide.decayString());
+        }
+      else
+        {
+          decay_branches.addEmptyIsotope();
+        }
+
       nubaseDataTable.emplace_back(nuclide);
+      ++stats.records;
     }
 
-  fmt::print("--> done\n");
+  isomers.link(nubaseDataTable);
+  indexNUBASE();
+
+  diagnostics.report({ Severity::INFO, DiagnosticCode::PROGRESS }, []() { return std::string("--> done\n"); });
   return true;
 }
 
 
 bool MassTable::mergeData() const
 {
-  fmt::print("Merging AME and NUBASE data <--");
+  auto& stats = load_stats[LoadPhase::MERGE];
+  const LoadStats::Timer timer(stats, allocation_probe);
+
+  diagnostics.report({ Severity::INFO, DiagnosticCode::PROGRESS },
+                     []() { return std::string("Merging AME and NUBASE data <--"); });
   if (ameDataTable.size() != nubaseDataTable.size())
     {
-      fmt::print("\n**WARNING** The AME data ({}) has a different number of isotopes to NUBASE ({})\n",
-                 ameDataTable.size(),
-                 nubaseDataTable.size());
+      diagnostics.report({ Severity::WARNING, DiagnosticCode::TABLE_SIZE_MISMATCH }, [this]() {
+        return fmt::format("\n**WARNING** The AME data ({}) has a different number of isotopes to NUBASE ({})\n",
+                           ameDataTable.size(),
+                           nubaseDataTable.size());
+      });
     }
 
   for (const auto& nubase : nubaseDataTable)
     {
-      const auto ame = std::find_if(ameDataTable.cbegin(), ameDataTable.cend(), [&nubase](const auto& AME) -> bool {
-        return (AME.A == nubase.A && AME.Z == nubase.Z);
-      });
+      const auto ame = findAME(nubase.key());
 
-      if (ame != ameDataTable.cend())
+      if (ame != ameDataTable.end())
         {
           fullDataTable.emplace_back(*ame, nubase);
+          ++stats.records;
+        }
+      else
+        {
+          ++stats.unmatched;
         }
     }
-  fmt::print("--> done\n");
+  diagnostics.report({ Severity::INFO, DiagnosticCode::PROGRESS }, []() { return std::string("--> done\n"); });
   return true;
 }
 
 
 bool MassTable::outputTableToJSON() const
 {
-  const auto outfile = fmt::format("masstable_{}.json", year);
+  readDeferredReactions();
+
+  auto& stats = load_stats[LoadPhase::EXPORT_JSON];
+  const LoadStats::Timer timer(stats, allocation_probe);
+  stats.records += static_cast<uint32_t>(fullDataTable.size());
+
+  const std::filesystem::path outfile{ fmt::format("masstable_{}.json", year) };
 
-  fmt::print("New json formatted file: {}\n", outfile);
-  auto out = fmt::output_file(outfile);
+  diagnostics.report({ Severity::INFO, DiagnosticCode::FILE_WRITTEN, &outfile },
+                     [&outfile]() { return fmt::format("New json formatted file: {}\n", outfile.string()); });
+  auto out = fmt::output_file(outfile.string());
+
+  auto isomer_out = openIsomerFile("ndjson", "");
 
   out.print("[\n");
   // The final element can't have a trailing comma, otherwise we'd use a range loop here
   for (auto isotope = fullDataTable.cbegin(); isotope != fullDataTable.cend(); ++isotope)
     {
       out.print("{}{}", isotope->writeAsJSON(), (isotope != std::prev(fullDataTable.end(), 1)) ? ",\n" : "");
+      writeIsomers(isomer_out, *isotope, NUBASE::IsomerTable::writeAsJSON);
     }
   out.print("\n]\n");
 
-  return true;
+  return closeIsomerFile(isomer_out);
 }
 
 
 bool MassTable::outputTableToCSV() const
 {
-  const auto outfile = fmt::format("masstable_{}.csv", year);
+  readDeferredReactions();
+
+  auto& stats = load_stats[LoadPhase::EXPORT_CSV];
+  const LoadStats::Timer timer(stats, allocation_probe);
+  stats.records += static_cast<uint32_t>(fullDataTable.size());
+
+  const std::filesystem::path outfile{ fmt::format("masstable_{}.csv", year) };
 
-  fmt::print("New csv formatted file: {}\n", outfile);
-  auto out = fmt::output_file(outfile);
+  diagnostics.report({ Severity::INFO, DiagnosticCode::FILE_WRITTEN, &outfile },
+                     [&outfile]() { return fmt::format("New csv formatted file: {}\n", outfile.string()); });
+  auto out = fmt::output_file(outfile.string());
+
+  auto isomer_out = openIsomerFile("csv", NUBASE::IsomerTable::writeCSVHeader());
 
   out.print("{}\n", Isotope::writeCSVHeader());
 
   for (const auto& isotope : fullDataTable)
     {
       out.print("{}\n", isotope.writeAsCSV());
+      writeIsomers(isomer_out, isotope, NUBASE::IsomerTable::writeAsCSV);
+    }
+
+  return closeIsomerFile(isomer_out);
+}
+
+
+std::ofstream MassTable::openIsomerFile(std::string_view extension, std::string_view header) const
+{
+  std::ofstream out;
+
+  if (isomer_export == IsomerExport::NONE)
+    {
+      return out;
+    }
+
+  const bool binary = (isomer_export == IsomerExport::BINARY);
+  const std::filesystem::path outfile{ fmt::format("masstable_{}_isomers.{}", year, binary ? "bin" : extension) };
+
+  out.open(outfile, binary ? std::ios::binary : std::ios::out);
+  if (!out)
+    {
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::FILE_NOT_WRITTEN, &outfile }, [&outfile]() {
+        return fmt::format("\n***ERROR***: {} could not be opened for writing\n\n", outfile.string());
+      });
+      return out;
+    }
+
+  diagnostics.report({ Severity::INFO, DiagnosticCode::FILE_WRITTEN, &outfile }, [&outfile, binary, extension]() {
+    return fmt::format("New {} formatted file: {}\n", binary ? "binary" : extension, outfile.string());
+  });
+
+  if (binary)
+    {
+      const auto file_header = NUBASE::IsomerTable::writeBinaryHeader();
+      out.write(file_header.data(), static_cast<std::streamsize>(file_header.size()));
+    }
+  else if (!header.empty())
+    {
+      out << header << '\n';
+    }
+
+  return out;
+}
+
+
+bool MassTable::closeIsomerFile(std::ofstream& out) const
+{
+  if (isomer_export == IsomerExport::NONE)
+    {
+      return true;
+    }
+
+  // A failed open has already been reported
+  if (!out.is_open())
+    {
+      return false;
+    }
+
+  out.close();
+  if (!out)
+    {
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::FILE_NOT_WRITTEN }, []() {
+        return std::string("\n***ERROR***: The isomeric states were not completely written\n\n");
+      });
+      return false;
     }
 
   return true;
 }
+
+
+void MassTable::writeIsomers(std::ofstream& out,
+                             const Isotope& isotope,
+                             std::string (*as_text)(const NUBASE::IsomerState&)) const
+{
+  if (!out.is_open())
+    {
+      return;
+    }
+
+  for (const auto& state : isomers.statesOf(isotope.nubase))
+    {
+      if (isomer_export == IsomerExport::BINARY)
+        {
+          const auto record = NUBASE::IsomerTable::writeAsBinary(state);
+          out.write(record.data(), static_cast<std::streamsize>(record.size()));
+        }
+      else
+        {
+          out << as_text(state) << '\n';
+        }
+    }
+}
@@ -1,16 +1,16 @@
 #include "nuclear-data-reader/nubase_data.hpp"
 
 #include "nuclear-data-reader/converter.hpp"
+#include "nuclear-data-reader/nubase_decay_mode.hpp"
+#include "nuclear-data-reader/nubase_isomer_table.hpp"
 #include "nuclear-data-reader/nubase_line_position.hpp"
 #include <string_view>
 
-#include <fmt/core.h>
-
 #include <algorithm>
 #include <array>
 #include <cctype>
 #include <cmath>
-#include <cstdio>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
@@ -19,12 +19,11 @@
 double NUBASE::Data::getRelativeMassExcessError(const double min_allowed) const
 {
   // 12C has an mass excess of 0.0 by definition.
-  // This is the only place it currently trips us up and this path does not always happen so, in terms of doing as
-  // little work as possible, this is the best place to check and make adjustments.
-  // The value we set does not matter as the error on the value is also 0.0 so relative error is guaranteed to be 0.0
+  // This is the only place it currently trips us up. The error on the value is also 0.0 so the relative error is 0.0,
+  // rather than the 0.0/0.0 we would calculate, and the stored value is left alone so this can be called concurrently.
   if (A == 12 && Z == 6)
     {
-      mass_excess.amount = 0.0001;
+      return std::max(0.0, min_allowed);
     }
 
   // Optional access is check in function so silence the linter for that specific check
@@ -33,73 +32,177 @@ double NUBASE::Data::getRelativeMassExcessError(const double min_allowed) const
 }
 
 
-std::string NUBASE::Data::cleanSpinParityString(std::string& spin_parity) const
+std::optional<NUBASE::Data::SpinParity> NUBASE::Data::parseSpinParity(std::string_view jpi) noexcept
 {
-  // HACKS for those nuclei with non-unique assignments.
-  // Remove 'unhelpful' characters
-  if (const auto unwanted = spin_parity.find_first_of("<>*"); unwanted != std::string::npos)
-    {
-      spin_parity.erase(unwanted, 1);
-    }
-  // 131I isomer 2 has (19/2+..23/2+) change to (19/2+)
-  else if (spin_parity.find("(19/2+..23/2+)") != std::string::npos)
-    {
-      spin_parity.replace(6, spin_parity.length(), ")");
-    }
-  // 118Rh has gs J=(4-10), take as 4
-  else if (const auto spin_alter = spin_parity.find("(4-10)"); spin_alter != std::string::npos)
-    {
-      spin_parity.erase(spin_alter + 2, 3);
-    }
-  // 176Tam has no J value, just (+). Executive decision; tentative 0+
-  else if (spin_parity.substr(0, 3) == "(+)")
-    {
-      spin_parity = "(0+)";
-    }
-  // 71Se isomer 1 has 1/2- to 9/2- change to 1/2-
-  else if (spin_parity.find("1/2-to9/2-") != std::string::npos)
-    {
-      spin_parity.replace(4, spin_parity.length(), "");
-    }
-  // 142Ho has (6 to 9) change to (6)
-  else if (spin_parity.find("(6to9)") != std::string::npos)
+  // Some values are set as words (high, low, mix, spmix, fsmix, am)
+  // Don't want this so tell the caller there is nothing to use
+  if (jpi.empty() || std::isalpha(static_cast<unsigned char>(jpi.front())) != 0)
     {
-      spin_parity.replace(2, spin_parity.length(), ")");
+      return std::nullopt;
     }
-  // Same string in both 2003 and 2012
-  // 42Sc isomer 5 has (1+ to 4+) change to (1+)
-  if (spin_parity.find("(1+to4+)") != std::string::npos)
+
+  // Ignore the random substrings that we aren't going to parse/use, and everything after them
+  constexpr std::array<std::string_view, 3> randoms{ "frg", "T=", "am" };
+  for (const auto random : randoms)
     {
-      spin_parity.replace(3, spin_parity.length(), ")");
+      if (const auto pos = jpi.find(random); pos != std::string_view::npos)
+        {
+          jpi = jpi.substr(0, pos);
+          break;
+        }
     }
-  // 38P has (0- to 4-) change to (0-)
-  if (spin_parity.find("0-to4-") != std::string::npos)
+
+  // The first value of spin and/or parity will be taken, e.g.
+  // 3/2-        -> J=1.5, negative parity
+  // (1,2)-      -> J=1, the parity applies to the list so is unknown for the first value
+  // (4-10)(+#)  -> J=4, positive parity, the range is skipped
+  // 1/2-to9/2-  -> J=0.5, negative parity
+  // (+)         -> J=0, positive parity
+  enum class State : uint8_t
+  {
+    START,
+    SPIN,
+    DENOMINATOR,
+    AFTER_SPIN,
+    PARITY,
+    RANGE,
+    DONE
+  };
+
+  SpinParity result;
+  auto state = State::START;
+  double spin{ 0.0 };
+  bool has_spin{ false };
+  bool half_integer{ false };
+  bool tentative{ false };
+
+  for (const auto character : jpi)
     {
-      spin_parity.replace(3, spin_parity.length(), ")");
+      // Brackets mean tentative values and hash (#) means theoretical, anywhere in the field.
+      // For the moment, we will call both of those theoretical.
+      if (character == '(' || character == '#')
+        {
+          tentative = true;
+        }
+
+      if (state == State::DONE)
+        {
+          continue;
+        }
+
+      // Skip everything up to the end of the bracket containing the second value of a range
+      if (state == State::RANGE)
+        {
+          if (character == ')')
+            {
+              state = State::AFTER_SPIN;
+            }
+          continue;
+        }
+
+      // Characters that don't change the value, including limits which we are not interested in
+      if (std::isspace(static_cast<unsigned char>(character)) != 0 || character == '(' || character == ')'
+          || character == '#' || character == '<' || character == '>' || character == '*')
+        {
+          continue;
+        }
+
+      const bool is_digit  = (character >= '0' && character <= '9');
+      const bool is_parity = (character == '+' || character == '-');
+
+      switch (state)
+        {
+          case State::START:
+            if (is_digit)
+              {
+                spin     = character - '0';
+                has_spin = true;
+                state    = State::SPIN;
+              }
+            else if (is_parity)
+              {
+                result.pi = (character == '-') ? Parity::NEGATIVE : Parity::POSITIVE;
+                state     = State::PARITY;
+              }
+            else
+              {
+                state = State::DONE;
+              }
+            break;
+          case State::SPIN:
+            if (is_digit)
+              {
+                spin = 10.0 * spin + (character - '0');
+              }
+            else if (character == '/')
+              {
+                state = State::DENOMINATOR;
+              }
+            else if (is_parity)
+              {
+                result.pi = (character == '-') ? Parity::NEGATIVE : Parity::POSITIVE;
+                state     = State::PARITY;
+              }
+            else
+              {
+                // A range given as x:y, otherwise the end of the value, e.g. a list (,) or x..y or x to y
+                state = (character == ':') ? State::RANGE : State::DONE;
+              }
+            break;
+          case State::DENOMINATOR:
+            half_integer = (character == '2');
+            state        = half_integer ? State::AFTER_SPIN : State::DONE;
+            break;
+          case State::AFTER_SPIN:
+            if (is_parity)
+              {
+                result.pi = (character == '-') ? Parity::NEGATIVE : Parity::POSITIVE;
+                state     = State::PARITY;
+              }
+            else
+              {
+                state = (character == ':') ? State::RANGE : State::DONE;
+              }
+            break;
+          case State::PARITY:
+            // A digit after the sign means it was a range, e.g. 4-10, rather than a parity
+            if (is_digit)
+              {
+                result.pi = Parity::UNKNOWN;
+                state     = State::RANGE;
+              }
+            else
+              {
+                state = State::DONE;
+              }
+            break;
+          case State::RANGE:
+          case State::DONE:
+          default:
+            break;
+        }
     }
-  // 118Agm has 0(-) to 2(-) change to 0(-)
-  else if (spin_parity.find("0(-)to2(-)") != std::string::npos)
+
+  // Nothing we can use
+  if (!has_spin && result.pi == Parity::UNKNOWN)
     {
-      spin_parity.erase(4);
+      return std::nullopt;
     }
-  // 35Sxi has (1/2:9/2)+ change to (1/2)+
-  else if (spin_parity.find("(1/2:9/2)+") != std::string::npos)
+
+  result.J = half_integer ? 0.5 * spin : spin;
+
+  if (tentative)
     {
-      spin_parity.replace(4, spin_parity.length(), ")+");
+      result.J_exp  = Measured::THEORETICAL;
+      result.pi_exp = Measured::THEORETICAL;
     }
-  // 2016
-  // Nothing additional to what has already been done
-  // 2020
-  // Nothing additional to what has already been done
 
-  return spin_parity;
+  return result;
 }
 
 
 void NUBASE::Data::setSpinParity() const
 {
-  // The first value of spin and/or parity will be taken
-
   // The information starts at character position.START_SPIN(79),
   // so if the line is not at least that length, set values to 'unknown' and get out.
   // OR
@@ -112,71 +215,19 @@ void NUBASE::Data::setSpinParity() const
       return;
     }
 
-  // Extract full assignment into a separated string and remove parts as we assign properties
-  std::string jpi = full_data.substr(position.START_SPIN, (position.END_SPIN - position.START_SPIN));
-  // Assume we have measured the spin and parity
-  // We'll alter these if it's not true
-  J_exp  = Measured::EXPERIMENTAL;
-  pi_exp = Measured::EXPERIMENTAL;
+  const auto spin_parity =
+      parseSpinParity(std::string_view(full_data).substr(position.START_SPIN, (position.END_SPIN - position.START_SPIN)));
 
-  // Some values are set as words (high, low, mix, spmix, fsmix, am)
-  // Don't want this so set all properties to default and get out.
-  if (std::isalpha(jpi.at(0)) != 0)
+  if (!spin_parity)
     {
       setAllSpinParityValuesAsUnknown();
       return;
     }
 
-  // Remove more random substrings that we aren't going to parse/use
-  constexpr std::array<std::string_view, 3> randoms{ "frg", "T=", "am" };
-  if (const auto str_pos =
-          std::find_if(randoms.cbegin(),
-                       randoms.cend(),
-                       [=](const auto character) { return jpi.find(character) != std::string_view::npos; });
-      str_pos != randoms.cend())
-    {
-      jpi.erase(jpi.find(*str_pos));
-    }
-
-  // Remove all white space
-  jpi.erase(std::remove_if(jpi.begin(), jpi.end(), [](const auto character) { return std::isspace(character); }),
-            jpi.end());
-
-  // Convert overly complicated assignments into more parseable ones
-  jpi = cleanSpinParityString(jpi);
-
-  // Brackets mean tentative values and hash (#) means theoretical
-  // FIXME: It's likely that any and all # characters has been removed by the time this function is run.
-  // For the moment, we will call both of those theoretical.
-  // If there is an opening ( then there will be also be a closing ) so don't bother checking
-  if (jpi.find('(') != std::string::npos || jpi.find('#') != std::string::npos)
-    {
-      std::erase_if(jpi, [](const auto character) { return character == '(' || character == ')' || character == '#'; });
-      pi_exp = Measured::THEORETICAL;
-      J_exp  = Measured::THEORETICAL;
-    }
-
-  // We are only storing one value per isotope.
-  // For those with multiple values, separated by a comma, drop everything after the first comma
-  if (const auto pos = jpi.find(','); pos != std::string::npos)
-    {
-      jpi.resize(pos);
-    }
-
-  // What is the parity of the state
-  if (jpi.ends_with('-') || jpi.ends_with('+'))
-    {
-      pi = jpi.ends_with('-') ? Parity::NEGATIVE : Parity::POSITIVE;
-      jpi.pop_back();
-    }
-  // If no parity symbol, set to 'unknown'
-  else
-    {
-      pi = Parity::UNKNOWN;
-    }
-
-  // Our string should now only be a number. Either x or x/2.
-  J = (jpi.ends_with("/2")) ? 0.5 * std::stod(jpi.substr(0, jpi.find('/'))) : std::stod(jpi);
+  J      = spin_parity->J;
+  pi     = spin_parity->pi;
+  J_exp  = spin_parity->J_exp;
+  pi_exp = spin_parity->pi_exp;
 }
 
 
@@ -195,26 +246,25 @@ void NUBASE::Data::setExperimental() const
 }
 
 
-void NUBASE::Data::setIsomerData(std::vector<NUBASE::Data>& nuc) const
+bool NUBASE::Data::setIsomerData(std::vector<NUBASE::Data>& nuc, IsomerTable& isomers) const
 {
   // Loop backwards through the existing isotopes to look for the correct ground state
   // Original order is ground state followed by ascending states,
   // theoretically we could just modify nuc.back(), but that's not safe
+  const auto wanted = key().groundState();
   if (auto ground_state = std::find_if(
-          nuc.rbegin(), nuc.rend(), [this](const auto& isotope) { return A == isotope.A && Z == isotope.Z; });
+          nuc.rbegin(), nuc.rend(), [wanted](const auto& isotope) { return isotope.key() == wanted; });
       ground_state != nuc.rend())
     {
       const auto energy = setIsomerEnergy();
       const auto error  = setIsomerEnergyError();
 
       // Some isomers(3 in total) are measured via beta difference so come out -ve
-      ground_state->energy_levels.emplace_back(level, energy < 0.0 ? energy : std::fabs(energy), error);
-    }
-  else
-    {
-      // Should never get here
-      fmt::print(stderr, "**WARNING**: This isomer has no matching ground-state\n");
+      isomers.add({ A, Z, level, energy < 0.0 ? energy : std::fabs(energy), error });
+      return true;
     }
+
+  return false;
 }
 
 
@@ -222,18 +272,15 @@ void NUBASE::Data::setHalfLife() const
 {
   // Annoying data file format strikes again
   // Line length is not always as long as the half life position
-  // Create a temporary string with either the half life or a known value
-  const std::string noUnit{ "no_units" };
+  const bool no_unit = (full_data.size() + 1 < position.START_HALFLIFEVALUE);
 
-  std::string lifetime =
-      (full_data.size() + 1 < position.START_HALFLIFEVALUE)
-          ? noUnit
-          : full_data.substr(position.START_HALFLIFEVALUE, (position.END_HALFLIFEVALUE - position.START_HALFLIFEVALUE));
+  const auto lifetime =
+      fieldView(position.START_HALFLIFEVALUE, (position.END_HALFLIFEVALUE - position.START_HALFLIFEVALUE));
 
   // If there is no unit on the half life, or the string contains certain characters, we shouldn't bother trying to
   // parse the values. Set as a very short half life and get out
-  if (lifetime == noUnit || lifetime.find_first_not_of(' ') == std::string::npos
-      || lifetime.find("p-unst") != std::string::npos || lifetime.find('R') != std::string::npos)
+  if (no_unit || lifetime.find_first_not_of(' ') == std::string_view::npos
+      || lifetime.find("p-unst") != std::string_view::npos || lifetime.find('R') != std::string_view::npos)
     {
       hl       = Converter::seconds{ 1.0e-24 };
       hl_error = Converter::seconds{ 1.0 };
@@ -241,22 +288,17 @@ void NUBASE::Data::setHalfLife() const
     }
 
   // If stable set to very long and get out
-  if (lifetime.find("stbl") != std::string::npos)
+  if (lifetime.find("stbl") != std::string_view::npos)
     {
       hl       = Converter::seconds{ 1.0e24 };
       hl_error = Converter::seconds{ 1.0 };
       return;
     }
 
-  // Not currently interested in approximations or limits
-  std::string_view remove{ "<>~" };
-  std::transform(lifetime.begin(), lifetime.end(), lifetime.begin(), [remove](const auto character) {
-    return remove.find(character) != std::string::npos ? ' ' : character;
-  });
-
+  // Not currently interested in approximations or limits so treat them as whitespace.
   // Get the numerical part of the half life that we can use to create a chrono value later
-  const auto hl_double =
-      Converter::StringToNum<double>(lifetime, 0, position.END_HALFLIFEVALUE - position.START_HALFLIFEVALUE);
+  const auto value     = Converter::TrimString(lifetime, " <>~");
+  const auto hl_double = Converter::StringToNum<double>(value, 0, static_cast<uint8_t>(value.size()));
 
   const auto hl_error_double = getNumericalHalfLifeError();
 
@@ -269,58 +311,38 @@ void NUBASE::Data::setHalfLife() const
 
 void NUBASE::Data::setDecayMode() const
 {
-  // Create a std::string we can play with and modify in this function
-  auto Decay =
-      (full_data.size() >= position.START_DECAYSTRING) ? full_data.substr(position.START_DECAYSTRING) : "isomer?";
+  // View the decay string rather than copying it
+  auto mode = (full_data.size() >= position.START_DECAYSTRING) ? decayString() : std::string_view{ "isomer?" };
 
   // The string format is ... complicated, see Section 2.5 of the 2016 paper
   // 10.1088/1674-1137/41/3/030001
   // Let's be relatively simple and take up to the first ';' only
-  if (Decay.find(';') != std::string::npos)
-    {
-      Decay.erase(Decay.find(';'));
-    }
+  mode = mode.substr(0, mode.find(';'));
 
   // Chop out everything after the '='
-  if (Decay.find('=') != std::string::npos)
+  if (const auto equals = mode.find('='); equals != std::string_view::npos)
     {
-      Decay.erase(Decay.find('='));
+      mode = mode.substr(0, equals);
     }
   // Or convert a guess/estimate to unknown
-  else if (Decay.find(" ?") != std::string::npos)
+  else if (mode.find(" ?") != std::string_view::npos)
     {
-      Decay = "unknown";
+      mode = "unknown";
     }
 
   // Remove from remaining unwanted characters to end
-  const auto found = Decay.find_first_of("~<> ");
-
-  if (found != std::string::npos)
-    {
-      Decay.erase(found);
-    }
-
-  // Book keeping
-  // swap e+ for B+
-  if (Decay == "e+")
-    {
-      Decay = "B+";
-    }
-  // use "stable" instead of "IS"
-  else if (Decay == "IS")
-    {
-      Decay = "stable";
-    }
+  mode = mode.substr(0, mode.find_first_of("~<> "));
 
-  decay = Decay;
+  // Book keeping, e.g. e+ -> B+
+  decay = DecayMode(DecayMode::canonical(mode));
 }
 
 
 void NUBASE::Data::setNeutronOrProtonRich(const bool is_neutron_rich) const noexcept
 {
-  rich = (!is_neutron_rich)    ? NUBASE::Richness::PROTON
-         : (decay == "stable") ? NUBASE::Richness::STABLE
-                               : NUBASE::Richness::NEUTRON;
+  rich = (!is_neutron_rich)                       ? NUBASE::Richness::PROTON
+         : (decay == DecayMode::common("stable")) ? NUBASE::Richness::STABLE
+                                                  : NUBASE::Richness::NEUTRON;
 
   // Tc(43) and Pm(61) have no stable isotopes so set the 'stable' point by hand
   switch (Z)
@@ -0,0 +1,152 @@
+#include "nuclear-data-reader/nubase_decay_branch.hpp"
+
+#include "nuclear-data-reader/converter.hpp"
+#include "nuclear-data-reader/nubase_decay_mode.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include <string_view>
+#include <system_error>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+
+namespace
+{
+  /**
+   * The uncertainty on a ratio is normally given in units of the last digit of the ratio, e.g. 80.1 7 is 80.1(7).
+   * Get the value of that last digit.
+   *
+   * \param The ratio as it is written in the data file
+   *
+   * \return The value of the final digit, e.g. 0.1 for 80.1
+   */
+  double lastDigitScale(const std::string_view ratio)
+  {
+    const auto exponent_position = ratio.find_first_of("eE");
+    const auto mantissa          = ratio.substr(0, exponent_position);
+
+    int exponent{ 0 };
+    if (exponent_position != std::string_view::npos)
+      {
+        const auto exponent_string = ratio.substr(exponent_position + 1);
+        // Leading '+' is not accepted by from_chars
+        const auto digits = exponent_string.starts_with('+') ? exponent_string.substr(1) : exponent_string;
+        std::from_chars(digits.data(), digits.data() + digits.size(), exponent);
+      }
+
+    const auto point    = mantissa.find('.');
+    const auto decimals = (point == std::string_view::npos) ? 0 : static_cast<int>(mantissa.size() - point - 1);
+
+    return std::pow(10.0, exponent - decimals);
+  }
+} // namespace
+
+
+NUBASE::DecayBranch NUBASE::DecayBranchTable::parseBranch(std::string_view branch)
+{
+  DecayBranch result;
+  result.ratio.amount = Number::MISSING;
+
+  branch = Converter::TrimString(branch);
+
+  // Continuation markers, e.g. '...', are not a mode
+  const auto mode = branch.substr(0, branch.find_first_of(" =~<>?"));
+  if (std::none_of(mode.cbegin(), mode.cend(), [](const auto character) {
+        return std::isalpha(static_cast<unsigned char>(character)) != 0;
+      }))
+    {
+      return result;
+    }
+
+  result.mode = DecayMode(DecayMode::canonical(mode));
+
+  // The 2 character qualifiers need to be checked before the single character ones
+  constexpr std::array<std::pair<std::string_view, Qualifier>, 13> qualifiers{ {
+      { "=?", Qualifier::UNKNOWN },
+      { "=<", Qualifier::LESS_OR_EQUAL },
+      { "<=", Qualifier::LESS_OR_EQUAL },
+      { "LE", Qualifier::LESS_OR_EQUAL },
+      { "=>", Qualifier::GREATER_OR_EQUAL },
+      { ">=", Qualifier::GREATER_OR_EQUAL },
+      { "GE", Qualifier::GREATER_OR_EQUAL },
+      { "=~", Qualifier::APPROXIMATE },
+      { "?", Qualifier::UNKNOWN },
+      { "=", Qualifier::EQUAL },
+      { "~", Qualifier::APPROXIMATE },
+      { "<", Qualifier::LESS },
+      { ">", Qualifier::GREATER },
+  } };
+
+  auto rest = Converter::TrimStart(branch.substr(mode.size()));
+  for (const auto& [symbol, qualifier] : qualifiers)
+    {
+      if (rest.starts_with(symbol))
+        {
+          result.qualifier = qualifier;
+          rest.remove_prefix(symbol.size());
+          break;
+        }
+    }
+
+  // Nothing more to read if the ratio is not known
+  if (result.qualifier == Qualifier::NONE || result.qualifier == Qualifier::UNKNOWN)
+    {
+      return result;
+    }
+
+  rest = Converter::TrimStart(rest);
+  const auto ratio = rest.substr(0, rest.find(' '));
+
+  // Anything after the number, e.g. the [gs=0,m=100] of B-=100[gs=0,m=100], is ignored
+  double amount{ 0.0 };
+  if (std::from_chars(ratio.data(), ratio.data() + ratio.size(), amount).ec != std::errc())
+    {
+      return result;
+    }
+  result.ratio.amount = amount;
+
+  rest                   = Converter::TrimStart(rest.substr(ratio.size()));
+  const auto uncertainty = rest.substr(0, rest.find(' '));
+
+  // Asymmetric uncertainties, e.g. +18-8, are not stored
+  double error{ 0.0 };
+  if (std::from_chars(uncertainty.data(), uncertainty.data() + uncertainty.size(), error).ec != std::errc())
+    {
+      return result;
+    }
+
+  // An uncertainty with a decimal point is already in the same units as the ratio
+  result.ratio.uncertainty =
+      (uncertainty.find('.') != std::string_view::npos) ? error : error * lastDigitScale(ratio);
+
+  return result;
+}
+
+
+std::size_t NUBASE::DecayBranchTable::addIsotope(std::string_view decay_string)
+{
+  std::size_t added{ 0 };
+
+  while (!decay_string.empty())
+    {
+      const auto end = decay_string.find(';');
+
+      if (auto branch = parseBranch(decay_string.substr(0, end)); branch.mode != DecayMode{})
+        {
+          branches.push_back(branch);
+          ++added;
+        }
+
+      decay_string = (end == std::string_view::npos) ? std::string_view{} : decay_string.substr(end + 1);
+    }
+
+  offsets.push_back(static_cast<uint32_t>(branches.size()));
+
+  return added;
+}
@@ -0,0 +1,64 @@
+#include "nuclear-data-reader/nubase_decay_mode.hpp"
+
+#include <string_view>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <string>
+
+
+namespace
+{
+  /// Modes that are not in DecayMode::common_modes, only ever added to so the strings are never moved
+  struct Registry
+  {
+    std::mutex mutex;
+    std::deque<std::string> modes;
+  };
+
+  Registry& registry()
+  {
+    static Registry instance;
+    return instance;
+  }
+} // namespace
+
+
+uint16_t NUBASE::DecayMode::intern(std::string_view mode)
+{
+  if (const auto found = std::find(common_modes.cbegin(), common_modes.cend(), mode); found != common_modes.cend())
+    {
+      return static_cast<uint16_t>(std::distance(common_modes.cbegin(), found));
+    }
+
+  auto& table = registry();
+  const std::scoped_lock lock(table.mutex);
+
+  auto found = std::find(table.modes.cbegin(), table.modes.cend(), mode);
+  if (found == table.modes.cend())
+    {
+      table.modes.emplace_back(mode);
+      found = std::prev(table.modes.cend());
+    }
+
+  const auto position = static_cast<std::size_t>(std::distance(table.modes.cbegin(), found));
+  return static_cast<uint16_t>(common_modes.size() + position);
+}
+
+
+std::string_view NUBASE::DecayMode::str() const
+{
+  if (id < common_modes.size())
+    {
+      return common_modes[id];
+    }
+
+  auto& table = registry();
+  const std::scoped_lock lock(table.mutex);
+
+  return table.modes[id - common_modes.size()];
+}
@@ -0,0 +1,101 @@
+#include "nuclear-data-reader/nubase_isomer_table.hpp"
+
+#include "nuclear-data-reader/converter.hpp"
+#include "nuclear-data-reader/nubase_data.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <string>
+
+
+void NUBASE::IsomerTable::link(std::span<const Data> ground_states)
+{
+  // The data file is already in this order, so this is normally just a check
+  const auto by_level = [](const IsomerState& lhs, const IsomerState& rhs) { return lhs.key() < rhs.key(); };
+
+  if (!std::is_sorted(states.cbegin(), states.cend(), by_level))
+    {
+      std::stable_sort(states.begin(), states.end(), by_level);
+    }
+
+  const auto by_isotope = [](const IsomerState& lhs, const IsomerState& rhs) {
+    return lhs.key().groundState() < rhs.key().groundState();
+  };
+
+  for (const auto& ground_state : ground_states)
+    {
+      const IsomerState key{ ground_state.A, ground_state.Z };
+      const auto [first, last] = std::equal_range(states.cbegin(), states.cend(), key, by_isotope);
+
+      ground_state.isomer_offset = static_cast<uint32_t>(std::distance(states.cbegin(), first));
+      ground_state.isomer_count  = static_cast<uint8_t>(std::distance(first, last));
+    }
+}
+
+
+std::span<const NUBASE::IsomerState> NUBASE::IsomerTable::statesOf(const Data& ground_state) const noexcept
+{
+  if (static_cast<std::size_t>(ground_state.isomer_offset) + ground_state.isomer_count > states.size())
+    {
+      return {};
+    }
+
+  return std::span<const IsomerState>(states).subspan(ground_state.isomer_offset, ground_state.isomer_count);
+}
+
+
+std::string NUBASE::IsomerTable::writeAsCSV(const IsomerState& state)
+{
+  return fmt::format("{},{},{},{},{}",
+                     state.A,
+                     state.Z,
+                     state.level,
+                     Converter::FloatToNdp(state.energy, NDP),
+                     Converter::FloatToNdp(state.error, NDP));
+}
+
+
+std::string NUBASE::IsomerTable::writeAsJSON(const IsomerState& state)
+{
+  return fmt::format(R"({{"A":{},"Z":{},"Level":{},"Energy":{},"ErrorEnergy":{}}})",
+                     state.A,
+                     state.Z,
+                     state.level,
+                     Converter::FloatToNdp(state.energy, NDP),
+                     Converter::FloatToNdp(state.error, NDP));
+}
+
+
+std::array<char, 16> NUBASE::IsomerTable::writeBinaryHeader() noexcept
+{
+  constexpr std::array<char, 8> magic{ 'N', 'D', 'R', 'I', 'S', 'O', '0', '1' };
+  constexpr auto record_size = static_cast<uint32_t>(BINARY_RECORD_SIZE);
+
+  std::array<char, 16> header{};
+  std::memcpy(header.data(), magic.data(), magic.size());
+  std::memcpy(header.data() + magic.size(), &record_size, sizeof(record_size));
+
+  return header;
+}
+
+
+std::array<char, NUBASE::IsomerTable::BINARY_RECORD_SIZE>
+NUBASE::IsomerTable::writeAsBinary(const IsomerState& state) noexcept
+{
+  // Copy each member rather than the struct so the padding is always zero
+  std::array<char, BINARY_RECORD_SIZE> record{};
+  std::memcpy(record.data(), &state.A, sizeof(state.A));
+  std::memcpy(record.data() + 2, &state.Z, sizeof(state.Z));
+  std::memcpy(record.data() + 4, &state.level, sizeof(state.level));
+  std::memcpy(record.data() + 8, &state.energy, sizeof(state.energy));
+  std::memcpy(record.data() + 16, &state.error, sizeof(state.error));
+
+  return record;
+}
@@ -0,0 +1,242 @@
+#include "nuclear-data-reader/query_engine.hpp"
+
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/query_protocol.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+#include "nuclear-data-reader/table_handle.hpp"
+#include "nuclear-data-reader/table_snapshot.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+QueryEngine::QueryEngine(std::span<const uint16_t> years)
+{
+  for (const auto year : years)
+    {
+      MassTable table(year);
+      if (!table.ValidYear(year) || find(table.year) != nullptr)
+        {
+          continue;
+        }
+
+      // The server reports what it is doing, the tables stay quiet
+      table.diagnostics.silence();
+      tables.push_back(std::make_unique<TableHandle>(std::move(table)));
+    }
+}
+
+
+std::vector<uint16_t> QueryEngine::years() const
+{
+  std::vector<uint16_t> served;
+  served.reserve(tables.size());
+  for (const auto& table : tables)
+    {
+      served.push_back(table->prototype.year);
+    }
+  return served;
+}
+
+
+bool QueryEngine::load()
+{
+  auto loaded{ true };
+  for (const auto& table : tables)
+    {
+      loaded = table->reload() && loaded;
+    }
+  return loaded;
+}
+
+
+void QueryEngine::reloadInBackground()
+{
+  for (const auto& table : tables)
+    {
+      // If a reload is already running, the files will be read by that one
+      [[maybe_unused]] const auto started = table->reloadInBackground();
+    }
+}
+
+
+const TableHandle* QueryEngine::find(const uint16_t year) const noexcept
+{
+  // 1997 is read from the 1995 files, see MassTable
+  const uint16_t table_year = (year == 1997) ? 1995 : year;
+
+  for (const auto& table : tables)
+    {
+      if (table->prototype.year == table_year)
+        {
+          return table.get();
+        }
+    }
+  return nullptr;
+}
+
+
+std::optional<std::size_t> QueryEngine::process(std::span<const std::byte> input,
+                                                std::vector<std::byte>& output,
+                                                const std::size_t output_limit) const
+{
+  std::size_t used{ 0 };
+
+  while (input.size() - used >= sizeof(Query::RequestHeader) && output.size() < output_limit)
+    {
+      const auto header = Query::read<Query::RequestHeader>(input, used);
+      if (header.payload_size > Query::MAX_PAYLOAD_SIZE)
+        {
+          return std::nullopt;
+        }
+
+      const auto start = used + sizeof(Query::RequestHeader);
+      if (input.size() - start < header.payload_size)
+        {
+          break;
+        }
+
+      answer(header, input.subspan(start, header.payload_size), output);
+      used = start + header.payload_size;
+    }
+
+  return used;
+}
+
+
+void QueryEngine::answer(const Query::RequestHeader& header,
+                         std::span<const std::byte> payload,
+                         std::vector<std::byte>& output) const
+{
+  Query::ResponseHeader response;
+  response.tag        = header.tag;
+  response.year       = header.year;
+  response.quantities = header.quantities;
+
+  const auto finish = [&output, &response](const std::size_t at) {
+    std::memcpy(output.data() + at, &response, sizeof(response));
+  };
+
+  const auto header_at = output.size();
+  Query::append(output, response);
+
+  const std::size_t entry_size = (header.operation == Query::Operation::LOOKUP)   ? sizeof(Query::Nuclide)
+                                 : (header.operation == Query::Operation::REGION) ? sizeof(Query::Region)
+                                                                                  : 0;
+
+  // Regions are only checked as they are answered, lookups have a row for every entry so are checked now
+  const auto row_size  = Query::rowSize(header.quantities);
+  const auto max_rows  = Query::MAX_RESPONSE_SIZE / row_size;
+  const auto too_large = header.operation == Query::Operation::LOOKUP && header.count > max_rows;
+
+  if (entry_size == 0 || (header.quantities & ~Query::ALL_QUANTITIES) != 0
+      || payload.size() != static_cast<std::size_t>(header.count) * entry_size || too_large)
+    {
+      response.status = Query::Status::BAD_REQUEST;
+      finish(header_at);
+      return;
+    }
+
+  const auto* const table = find(header.year);
+  if (table == nullptr)
+    {
+      response.status = Query::Status::UNKNOWN_YEAR;
+      finish(header_at);
+      return;
+    }
+
+  // Hold on to this version of the table until the whole request has been answered
+  const auto pin = table->pin();
+  if (!pin)
+    {
+      response.status = Query::Status::NOT_LOADED;
+      finish(header_at);
+      return;
+    }
+
+  if (header.operation == Query::Operation::LOOKUP)
+    {
+      output.reserve(output.size() + header.count * row_size);
+      for (std::size_t entry = 0; entry < header.count; ++entry)
+        {
+          const auto nuclide = Query::read<Query::Nuclide>(payload, entry * entry_size);
+          appendRow(*pin, pin->find(nuclide.A, nuclide.Z), nuclide, header.quantities, output);
+        }
+    }
+  else
+    {
+      std::size_t rows{ 0 };
+      for (std::size_t entry = 0; entry < header.count; ++entry)
+        {
+          const auto region   = Query::read<Query::Region>(payload, entry * entry_size);
+          const auto isotopes = pin->getRegion(region.Zmin, region.Zmax, region.Nmin, region.Nmax);
+
+          // Regions can overlap, so even a small request can ask for more than can be sent
+          rows += isotopes.size();
+          if (rows > max_rows)
+            {
+              output.resize(header_at + sizeof(response));
+              response.status = Query::Status::BAD_REQUEST;
+              finish(header_at);
+              return;
+            }
+
+          for (const auto row : isotopes)
+            {
+              appendRow(*pin, row, {}, header.quantities, output);
+            }
+        }
+    }
+
+  const auto rows       = (output.size() - header_at - sizeof(response)) / row_size;
+  response.count        = static_cast<uint32_t>(rows);
+  response.payload_size = static_cast<uint32_t>(rows * row_size);
+  finish(header_at);
+}
+
+
+void QueryEngine::appendRow(const TableSnapshot& snapshot,
+                            const std::optional<std::size_t> row,
+                            const Query::Nuclide nuclide,
+                            const uint32_t quantities,
+                            std::vector<std::byte>& output)
+{
+  constexpr auto missing = std::numeric_limits<double>::quiet_NaN();
+  // The table stores values that are not known as Number::MISSING, the protocol sends them as NaN
+  const auto as_sent = [](const double stored) { return Number::isMissing(stored) ? missing : stored; };
+
+  Query::RowHeader row_header{ nuclide.A,
+                               nuclide.Z,
+                               static_cast<uint16_t>((nuclide.A >= nuclide.Z) ? nuclide.A - nuclide.Z : 0),
+                               0 };
+  if (row)
+    {
+      const auto found = snapshot.nuclide(row.value());
+      row_header       = { found.A, found.Z, found.N, Query::FOUND };
+    }
+  Query::append(output, row_header);
+
+  for (const auto quantity : all_quantities)
+    {
+      if ((quantities & Query::select(quantity)) == 0)
+        {
+          continue;
+        }
+
+      Query::Value value{ missing, missing };
+      if (row)
+        {
+          const auto number = snapshot.getQuantity(row.value(), quantity);
+          value             = { as_sent(number.amount), as_sent(number.uncertainty.value_or(missing)) };
+        }
+      Query::append(output, value);
+    }
+}
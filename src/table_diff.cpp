@@ -0,0 +1,193 @@
+#include "nuclear-data-reader/table_diff.hpp"
+
+#include "nuclear-data-reader/converter.hpp"
+#include "nuclear-data-reader/diagnostics.hpp"
+#include "nuclear-data-reader/isotope.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+#include <fmt/os.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+std::vector<std::pair<NuclideKey, uint32_t>> TableDiff::sortedIndex(const std::vector<Isotope>& table)
+{
+  std::vector<std::pair<NuclideKey, uint32_t>> index;
+  index.reserve(table.size());
+
+  for (uint32_t position = 0; position < table.size(); ++position)
+    {
+      index.emplace_back(table[position].ame.key(), position);
+    }
+
+  std::sort(index.begin(), index.end());
+
+  return index;
+}
+
+
+bool TableDiff::compare(const MassTable& before, const MassTable& after)
+{
+  added.clear();
+  removed.clear();
+  changed.clear();
+
+  if (before.fullDataTable.empty() || after.fullDataTable.empty())
+    {
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::OUT_OF_ORDER },
+                         []() { return std::string("Both tables must be populated before they can be compared\n"); });
+      return false;
+    }
+
+  if (std::any_of(quantities.cbegin(), quantities.cend(), isReactionQuantity))
+    {
+      before.readDeferredReactions();
+      after.readDeferredReactions();
+    }
+
+  year_before = before.year;
+  year_after  = after.year;
+
+  const auto before_index = sortedIndex(before.fullDataTable);
+  const auto after_index  = sortedIndex(after.fullDataTable);
+
+  // Walk both sorted indices together, storing the table positions of the isotopes common to both
+  std::vector<uint32_t> before_common;
+  std::vector<uint32_t> after_common;
+  before_common.reserve(std::min(before_index.size(), after_index.size()));
+  after_common.reserve(before_common.capacity());
+
+  auto old_key = before_index.cbegin();
+  auto new_key = after_index.cbegin();
+  while (old_key != before_index.cend() || new_key != after_index.cend())
+    {
+      if (new_key == after_index.cend() || (old_key != before_index.cend() && old_key->first < new_key->first))
+        {
+          removed.push_back({ old_key->first.A(), old_key->first.Z() });
+          ++old_key;
+        }
+      else if (old_key == before_index.cend() || new_key->first < old_key->first)
+        {
+          added.push_back({ new_key->first.A(), new_key->first.Z() });
+          ++new_key;
+        }
+      else
+        {
+          before_common.push_back(old_key->second);
+          after_common.push_back(new_key->second);
+          ++old_key;
+          ++new_key;
+        }
+    }
+
+  const auto common = before_common.size();
+
+  // Missing values are replaced with NaN so they drop out of the comparison
+  const auto as_value = [](const double value) {
+    return Number::isMissing(value) ? std::numeric_limits<double>::quiet_NaN() : value;
+  };
+  const auto as_error = [](const Number& number) {
+    const auto error = number.uncertainty.value_or(0.0);
+    return Number::isMissing(error) ? 0.0 : error;
+  };
+
+  // Columns are reused for each quantity, so only allocate once
+  std::vector<double> old_value(common);
+  std::vector<double> old_error(common);
+  std::vector<double> new_value(common);
+  std::vector<double> new_error(common);
+  std::vector<double> delta(common);
+  std::vector<double> significance(common);
+
+  for (const auto quantity : quantities)
+    {
+      for (std::size_t i = 0; i < common; ++i)
+        {
+          const auto old_number = before.fullDataTable[before_common[i]].getQuantity(quantity);
+          const auto new_number = after.fullDataTable[after_common[i]].getQuantity(quantity);
+
+          old_value[i] = as_value(old_number.amount);
+          old_error[i] = as_error(old_number);
+          new_value[i] = as_value(new_number.amount);
+          new_error[i] = as_error(new_number);
+        }
+
+      // Branch free so the compiler is able to vectorise
+      for (std::size_t i = 0; i < common; ++i)
+        {
+          delta[i]        = new_value[i] - old_value[i];
+          significance[i] = delta[i] / std::sqrt(old_error[i] * old_error[i] + new_error[i] * new_error[i]);
+        }
+
+      for (std::size_t i = 0; i < common; ++i)
+        {
+          // NaN will fail this comparison so values missing from either table are also skipped
+          if (!(std::fabs(delta[i]) > threshold))
+            {
+              continue;
+            }
+
+          const auto& isotope = after.fullDataTable[after_common[i]];
+          changed.push_back(
+              { isotope.ame.A, isotope.ame.Z, quantity, old_value[i], new_value[i], delta[i], significance[i] });
+        }
+    }
+
+  return true;
+}
+
+
+bool TableDiff::outputDiffToCSV() const
+{
+  if (year_before == 0 || year_after == 0)
+    {
+      diagnostics.report({ Severity::ERROR, DiagnosticCode::OUT_OF_ORDER }, []() {
+        return std::string("Tables must be compared before the differences can be written\n");
+      });
+      return false;
+    }
+
+  const std::filesystem::path outfile{ fmt::format("masstable_diff_{}_{}.csv", year_before, year_after) };
+
+  diagnostics.report({ Severity::INFO, DiagnosticCode::FILE_WRITTEN, &outfile },
+                     [&outfile]() { return fmt::format("New csv formatted file: {}\n", outfile.string()); });
+  auto out = fmt::output_file(outfile.string());
+
+  out.print("{}\n", writeCSVHeader());
+
+  for (const auto& isotope : removed)
+    {
+      out.print("{},{},removed,,,,,\n", isotope.A, isotope.Z);
+    }
+
+  for (const auto& isotope : added)
+    {
+      out.print("{},{},added,,,,,\n", isotope.A, isotope.Z);
+    }
+
+  for (const auto& change : changed)
+    {
+      out.print("{},{},changed,{},{},{},{},{}\n",
+                change.A,
+                change.Z,
+                printQuantity(change.quantity),
+                Converter::FloatToNdp(change.before, Isotope::NDP),
+                Converter::FloatToNdp(change.after, Isotope::NDP),
+                Converter::FloatToNdp(change.delta, Isotope::NDP),
+                Converter::FloatToNdp(change.significance, 2));
+    }
+
+  return true;
+}
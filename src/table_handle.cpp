@@ -0,0 +1,88 @@
+#include "nuclear-data-reader/table_handle.hpp"
+
+#include "nuclear-data-reader/massTable.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+
+TableHandle::~TableHandle()
+{
+  if (loader.joinable())
+    {
+      loader.join();
+    }
+
+  delete current.load();
+}
+
+
+TableHandle::Pin TableHandle::pin() const noexcept
+{
+  // Registering as a reader before loading the pointer means a reload either sees us, or swapped before we looked
+  auto& counter = readers[epoch.load() & 1U].count;
+  counter.fetch_add(1);
+
+  return Pin(current.load(), &counter);
+}
+
+
+bool TableHandle::reload()
+{
+  const std::scoped_lock lock(reload_mutex);
+
+  MassTable table(prototype);
+  if (!table.populateInternalMassTable() || table.fullDataTable.empty())
+    {
+      return false;
+    }
+
+  auto next = std::make_unique<const Version>(table, published.load() + 1);
+  const auto number = next->number;
+
+  const auto* const previous = current.exchange(next.release());
+  published.store(number);
+
+  waitForReaders();
+  delete previous;
+
+  return true;
+}
+
+
+bool TableHandle::reloadInBackground()
+{
+  if (loading.exchange(true))
+    {
+      return false;
+    }
+
+  // The previous background reload has finished, or loading would still be set
+  if (loader.joinable())
+    {
+      loader.join();
+    }
+
+  loader = std::thread([this]() {
+    [[maybe_unused]] const auto reloaded = reload();
+    loading.store(false);
+  });
+
+  return true;
+}
+
+
+void TableHandle::waitForReaders()
+{
+  for (auto flip = 0; flip < 2; ++flip)
+    {
+      const auto previous = epoch.fetch_add(1) & 1U;
+      while (readers[previous].count.load(std::memory_order_acquire) != 0)
+        {
+          std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#include "nuclear-data-reader/table_snapshot.hpp"
+
+#include "nuclear-data-reader/chart_index.hpp"
+#include "nuclear-data-reader/isotope.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/nubase_data.hpp"
+#include "nuclear-data-reader/nubase_decay_branch.hpp"
+#include "nuclear-data-reader/nubase_isomer_table.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+TableSnapshot::TableSnapshot(const MassTable& table) : year(table.year)
+{
+  // Make sure nothing in the table is waiting to be read
+  table.readDeferredReactions();
+
+  const auto& isotopes = table.fullDataTable;
+
+  nuclides.reserve(isotopes.size());
+  values.reserve(isotopes.size() * all_quantities.size());
+  branch_offsets.reserve(isotopes.size() + 1);
+  isomer_offsets.reserve(isotopes.size() + 1);
+
+  // The merge keeps the order NUBASE was read in, so the matching row is almost always the next one
+  std::size_t nubase_row{ 0 };
+  const auto& nubase = table.nubaseDataTable;
+  const auto find_nubase_row = [&nubase, &nubase_row](const NuclideKey key) {
+    const auto matches = [key](const NUBASE::Data& data) { return data.key() == key; };
+
+    auto found =
+        std::find_if(std::next(nubase.cbegin(), static_cast<std::ptrdiff_t>(nubase_row)), nubase.cend(), matches);
+    if (found == nubase.cend())
+      {
+        found = std::find_if(nubase.cbegin(), nubase.cend(), matches);
+      }
+    if (found != nubase.cend())
+      {
+        nubase_row = static_cast<std::size_t>(std::distance(nubase.cbegin(), found));
+      }
+    return found;
+  };
+
+  for (const auto& isotope : isotopes)
+    {
+      nuclides.push_back({ isotope.ame.A, isotope.ame.Z, isotope.ame.N });
+
+      for (const auto quantity : all_quantities)
+        {
+          values.push_back(isotope.getQuantity(quantity));
+        }
+
+      if (const auto row = find_nubase_row(isotope.ame.key()); row != nubase.cend())
+        {
+          const auto found =
+              table.decay_branches.branchesOf(static_cast<std::size_t>(std::distance(nubase.cbegin(), row)));
+          branches.insert(branches.end(), found.begin(), found.end());
+        }
+      branch_offsets.push_back(static_cast<uint32_t>(branches.size()));
+
+      const auto states = table.isomers.statesOf(isotope.nubase);
+      isomers.insert(isomers.end(), states.begin(), states.end());
+      isomer_offsets.push_back(static_cast<uint32_t>(isomers.size()));
+    }
+
+  index.build(isotopes);
+}
+
+
+std::optional<std::size_t> TableSnapshot::find(const uint16_t A, const uint16_t Z) const noexcept
+{
+  if (A < Z)
+    {
+      return std::nullopt;
+    }
+
+  const auto position = index.position(Z, static_cast<uint16_t>(A - Z));
+  return (position != ChartIndex::NO_ISOTOPE) ? std::optional<std::size_t>{ position } : std::nullopt;
+}
+
+
+std::optional<Number> TableSnapshot::getQuantity(const uint16_t A, const uint16_t Z, const Quantity quantity) const
+{
+  const auto row = find(A, Z);
+  return row ? std::optional<Number>{ getQuantity(row.value(), quantity) } : std::nullopt;
+}
+
+
+std::span<const NUBASE::DecayBranch> TableSnapshot::getDecayBranches(const uint16_t A, const uint16_t Z) const noexcept
+{
+  const auto row = find(A, Z);
+  return row ? std::span<const NUBASE::DecayBranch>(branches).subspan(branch_offsets[row.value()],
+                                                                     branch_offsets[row.value() + 1]
+                                                                         - branch_offsets[row.value()])
+             : std::span<const NUBASE::DecayBranch>{};
+}
+
+
+std::span<const NUBASE::IsomerState> TableSnapshot::getIsomers(const uint16_t A, const uint16_t Z) const noexcept
+{
+  const auto row = find(A, Z);
+  return row ? std::span<const NUBASE::IsomerState>(isomers).subspan(isomer_offsets[row.value()],
+                                                                    isomer_offsets[row.value() + 1]
+                                                                        - isomer_offsets[row.value()])
+             : std::span<const NUBASE::IsomerState>{};
+}
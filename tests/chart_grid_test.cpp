@@ -0,0 +1,108 @@
+#include "nuclear-data-reader/chart_grid.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+
+
+TEST_CASE("The table must be populated before the grid is filled", "[ChartGrid]")
+{
+  const MassTable table(2020);
+  ChartGrid grid;
+  grid.diagnostics.silence();
+
+  REQUIRE_FALSE(grid.fill(table, Quantity::AME_MASS_EXCESS));
+  REQUIRE_FALSE(grid.outputGridToBinary());
+  REQUIRE_FALSE(grid.outputGridToMatrix());
+  REQUIRE_FALSE(grid.at(8, 11).has_value());
+}
+
+
+TEST_CASE("Fill a grid from a table", "[ChartGrid]")
+{
+  MassTable table(2020);
+  table.diagnostics.silence();
+  REQUIRE(table.populateInternalMassTable());
+
+  ChartGrid grid;
+
+  SECTION("Values are copied to their point on the chart")
+  {
+    REQUIRE(grid.fill(table, Quantity::AME_MASS_EXCESS));
+    REQUIRE(grid.year == 2020);
+    REQUIRE(grid.rows == 119);
+    REQUIRE(grid.columns == 178);
+    REQUIRE(grid.value.size() == std::size_t{ 119 } * 178);
+
+    const auto oxygen = grid.at(8, 11);
+    REQUIRE(oxygen.has_value());
+    REQUIRE_THAT(oxygen->amount, Catch::Matchers::WithinAbs(3332.858, 0.001));
+    REQUIRE(oxygen->uncertainty.has_value());
+
+    REQUIRE(grid.exists[grid.slot(8, 11)] == 1);
+    REQUIRE(static_cast<std::size_t>(std::count(grid.exists.cbegin(), grid.exists.cend(), 1))
+            == table.fullDataTable.size());
+
+    // Nothing at, or past, the edge of the chart
+    REQUIRE(grid.exists[grid.slot(100, 1)] == 0);
+    REQUIRE(std::isnan(grid.value[grid.slot(100, 1)]));
+    REQUIRE_FALSE(grid.at(200, 1).has_value());
+  }
+
+  SECTION("Deferred reactions are read when needed")
+  {
+    REQUIRE(grid.fill(table, Quantity::S_N));
+    REQUIRE_THAT(grid.at(8, 11)->amount, Catch::Matchers::WithinAbs(3955.6439, 0.001));
+
+    // Hydrogen exists but has no neutron to separate
+    REQUIRE(grid.exists[grid.slot(1, 0)] == 1);
+    REQUIRE_FALSE(grid.at(1, 0).has_value());
+  }
+
+  SECTION("The binary header describes the grid")
+  {
+    REQUIRE(grid.fill(table, Quantity::HALF_LIFE));
+    const auto header = grid.writeBinaryHeader();
+
+    REQUIRE(std::memcmp(header.data(), "NDRGRD01", 8) == 0);
+
+    uint16_t year{ 0 };
+    uint16_t rows{ 0 };
+    uint16_t columns{ 0 };
+    std::memcpy(&year, header.data() + 8, sizeof(year));
+    std::memcpy(&rows, header.data() + 12, sizeof(rows));
+    std::memcpy(&columns, header.data() + 14, sizeof(columns));
+
+    REQUIRE(year == 2020);
+    REQUIRE(static_cast<Quantity>(header[10]) == Quantity::HALF_LIFE);
+    REQUIRE(header[11] == 0);
+    REQUIRE(rows == grid.rows);
+    REQUIRE(columns == grid.columns);
+  }
+
+  SECTION("A file that can't be written is reported")
+  {
+    grid.diagnostics.silence();
+    REQUIRE(grid.fill(table, Quantity::HALF_LIFE));
+
+    // A directory can't be opened as a file
+    const std::filesystem::path outfile{ "masstable_2020_" + printQuantity(Quantity::HALF_LIFE) + ".bin" };
+    std::filesystem::remove(outfile);
+    std::filesystem::create_directory(outfile);
+    REQUIRE_FALSE(grid.outputGridToBinary());
+    REQUIRE(grid.diagnostics.count(Severity::ERROR) == 1);
+    std::filesystem::remove(outfile);
+
+    REQUIRE(grid.outputGridToBinary());
+    REQUIRE(std::filesystem::file_size(outfile)
+            == ChartGrid::BINARY_HEADER_SIZE + grid.value.size() * (2 * sizeof(double) + 1));
+    std::filesystem::remove(outfile);
+  }
+}
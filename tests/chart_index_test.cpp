@@ -0,0 +1,158 @@
+#include "nuclear-data-reader/chart_index.hpp"
+#include "nuclear-data-reader/isotope.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+TEST_CASE("Build the index", "[ChartIndex]")
+{
+  std::vector<Isotope> table;
+  const auto add_isotope = [&table](const uint16_t Z, const uint16_t N) {
+    AME::Data ame("", 2020);
+    ame.Z = Z;
+    ame.N = N;
+    ame.A = Z + N;
+    table.emplace_back(ame, NUBASE::Data("", 2020));
+  };
+
+  // Deliberately not in chart order
+  add_isotope(2, 2);
+  add_isotope(1, 0);
+  add_isotope(2, 1);
+  add_isotope(1, 1);
+  add_isotope(4, 5);
+
+  ChartIndex index;
+  REQUIRE(index.empty());
+
+  index.build(table);
+
+  SECTION("Entries are ordered by Z then N")
+  {
+    REQUIRE(index.by_Z == std::vector<uint32_t>{ 1, 3, 2, 0, 4 });
+    REQUIRE(index.N_by_Z == std::vector<uint16_t>{ 0, 1, 1, 2, 5 });
+  }
+
+  SECTION("Offsets mark the start of each row")
+  {
+    REQUIRE(index.Z_offset == std::vector<uint32_t>{ 0, 0, 2, 4, 4, 5 });
+  }
+
+  SECTION("Rectangular regions")
+  {
+    REQUIRE(index.region(1, 2, 1, 1) == std::vector<uint32_t>{ 3, 2 });
+    REQUIRE(index.region(0, 200, 0, 200).size() == table.size());
+    REQUIRE(index.region(3, 3, 0, 10).empty());
+    REQUIRE(index.region(50, 60, 0, 10).empty());
+    REQUIRE(index.region(2, 1, 0, 10).empty());
+  }
+
+  SECTION("Single isotopes from the grid")
+  {
+    REQUIRE(index.grid_height == 5);
+    REQUIRE(index.grid_width == 6);
+    REQUIRE(index.position(2, 1) == 2);
+    REQUIRE(index.position(4, 5) == 4);
+    REQUIRE(index.position(3, 3) == ChartIndex::NO_ISOTOPE);
+    REQUIRE(index.position(4, 6) == ChartIndex::NO_ISOTOPE);
+    REQUIRE(index.position(5, 0) == ChartIndex::NO_ISOTOPE);
+  }
+
+  SECTION("Clearing the index")
+  {
+    index.clear();
+    REQUIRE(index.empty());
+    REQUIRE(index.region(0, 10, 0, 10).empty());
+    REQUIRE(index.position(1, 0) == ChartIndex::NO_ISOTOPE);
+  }
+}
+
+
+TEST_CASE("Region of a populated table", "[ChartIndex]")
+{
+  MassTable table(2020);
+  REQUIRE(table.populateInternalMassTable());
+
+  const uint16_t Zmin{ 20 };
+  const uint16_t Zmax{ 28 };
+  const uint16_t Nmin{ 20 };
+  const uint16_t Nmax{ 28 };
+
+  const auto region = table.getRegion(Zmin, Zmax, Nmin, Nmax);
+
+  REQUIRE(region.size() == 81);
+
+  std::size_t count{ 0 };
+  for (const auto& isotope : table.fullDataTable)
+    {
+      if (isotope.ame.Z >= Zmin && isotope.ame.Z <= Zmax && isotope.ame.N >= Nmin && isotope.ame.N <= Nmax)
+        {
+          ++count;
+        }
+    }
+  REQUIRE(count == region.size());
+
+  REQUIRE(region.front()->ame.Z == Zmin);
+  REQUIRE(region.front()->ame.N == Nmin);
+  REQUIRE(region.back()->ame.Z == Zmax);
+  REQUIRE(region.back()->ame.N == Nmax);
+}
+
+
+TEST_CASE("Isotopic, isotonic and isobaric chains", "[ChartIndex]")
+{
+  MassTable table(2020);
+  REQUIRE(table.populateInternalMassTable());
+  const auto& index = table.chart_index;
+
+  SECTION("Isotopes")
+  {
+    const auto chain = index.isotopicChain(50);
+    REQUIRE_FALSE(chain.empty());
+    REQUIRE(std::all_of(chain.begin(), chain.end(), [&table](const auto position) {
+      return table.fullDataTable[position].ame.Z == 50;
+    }));
+    REQUIRE(std::is_sorted(chain.begin(), chain.end(), [&table](const auto lhs, const auto rhs) {
+      return table.fullDataTable[lhs].ame.N < table.fullDataTable[rhs].ame.N;
+    }));
+    REQUIRE(chain.size() == static_cast<std::size_t>(std::count_if(
+                table.fullDataTable.cbegin(), table.fullDataTable.cend(), [](const auto& iso) { return iso.ame.Z == 50; })));
+  }
+
+  SECTION("Isotones")
+  {
+    const auto chain = index.isotonicChain(82);
+    REQUIRE_FALSE(chain.empty());
+    REQUIRE(std::all_of(chain.begin(), chain.end(), [&table](const auto position) {
+      return table.fullDataTable[position].ame.N == 82;
+    }));
+    REQUIRE(std::is_sorted(chain.begin(), chain.end(), [&table](const auto lhs, const auto rhs) {
+      return table.fullDataTable[lhs].ame.Z < table.fullDataTable[rhs].ame.Z;
+    }));
+  }
+
+  SECTION("Isobars")
+  {
+    const auto chain = index.isobaricChain(100);
+    REQUIRE_FALSE(chain.empty());
+    REQUIRE(std::all_of(chain.begin(), chain.end(), [&table](const auto position) {
+      return table.fullDataTable[position].ame.A == 100;
+    }));
+    REQUIRE(std::is_sorted(chain.begin(), chain.end(), [&table](const auto lhs, const auto rhs) {
+      return table.fullDataTable[lhs].ame.Z < table.fullDataTable[rhs].ame.Z;
+    }));
+  }
+
+  SECTION("Chains that do not exist are empty")
+  {
+    REQUIRE(index.isotopicChain(200).empty());
+    REQUIRE(index.isotonicChain(1000).empty());
+    REQUIRE(index.isobaricChain(1000).empty());
+  }
+}
@@ -4,6 +4,13 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_all.hpp>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+
 
 TEST_CASE("Symbol -> Z", "[Converter]")
 {
@@ -26,6 +33,55 @@ TEST_CASE("Symbol -> Z", "[Converter]")
 }
 
 
+TEST_CASE("Every symbol round trips", "[Converter]")
+{
+  for (const auto& [symbol, Z] : Converter::symbolZmap)
+    {
+      REQUIRE(Converter::SymbolToZ(symbol).value() == Z);
+      REQUIRE(Converter::ZToSymbol(Z).value() == symbol);
+    }
+}
+
+
+TEST_CASE("Nuclide label -> A and Z", "[Converter]")
+{
+  SECTION("Valid labels")
+  {
+    const auto lead = std::make_pair<uint16_t, uint16_t>(208, 82);
+    REQUIRE(Converter::LabelToAZ("208Pb") == lead);
+    REQUIRE(Converter::LabelToAZ("Pb208") == lead);
+    REQUIRE(Converter::LabelToAZ("Pb-208") == lead);
+    REQUIRE(Converter::LabelToAZ("  208Pb ") == lead);
+    REQUIRE(Converter::LabelToAZ("1n") == std::make_pair<uint16_t, uint16_t>(1, 0));
+    REQUIRE(Converter::LabelToAZ("H1") == std::make_pair<uint16_t, uint16_t>(1, 1));
+  }
+
+  SECTION("Invalid labels")
+  {
+    REQUIRE_FALSE(Converter::LabelToAZ("").has_value());
+    REQUIRE_FALSE(Converter::LabelToAZ("Pb").has_value());
+    REQUIRE_FALSE(Converter::LabelToAZ("208").has_value());
+    REQUIRE_FALSE(Converter::LabelToAZ("208PB").has_value());
+    REQUIRE_FALSE(Converter::LabelToAZ("208Xy").has_value());
+    REQUIRE_FALSE(Converter::LabelToAZ("Pb208x").has_value());
+    REQUIRE_FALSE(Converter::LabelToAZ("50Pb").has_value());
+    REQUIRE_FALSE(Converter::LabelToAZ("99999Pb").has_value());
+  }
+
+  SECTION("Many labels at once")
+  {
+    const std::array<std::string_view, 4> labels{ "4He", "C12", "bad", "238U" };
+    std::array<std::optional<std::pair<uint16_t, uint16_t>>, 4> results{};
+
+    REQUIRE(Converter::LabelsToAZ(labels, results) == 3);
+    REQUIRE(results[0] == std::make_pair<uint16_t, uint16_t>(4, 2));
+    REQUIRE(results[1] == std::make_pair<uint16_t, uint16_t>(12, 6));
+    REQUIRE_FALSE(results[2].has_value());
+    REQUIRE(results[3] == std::make_pair<uint16_t, uint16_t>(238, 92));
+  }
+}
+
+
 TEST_CASE("Z -> Symbol", "[Converter]")
 {
   SECTION("A valid proton number is given")
@@ -62,6 +118,72 @@ TEST_CASE("Float -> string", "[Converter]")
 }
 
 
+TEST_CASE("Value and unit -> duration", "[Converter]")
+{
+  constexpr double value{ 2.5 };
+
+  SECTION("Every unit gives the same value as std::chrono")
+  {
+    REQUIRE(Converter::ToDuration(value, "ys") == Converter::attoseconds{ 1.0e-6 * value });
+    REQUIRE(Converter::ToDuration(value, "zs") == Converter::attoseconds{ 1.0e-3 * value });
+    REQUIRE(Converter::ToDuration(value, "as") == Converter::attoseconds{ value });
+    REQUIRE(Converter::ToDuration(value, "ps") == Converter::picoseconds{ value });
+    REQUIRE(Converter::ToDuration(value, "ns") == Converter::nanoseconds{ value });
+    REQUIRE(Converter::ToDuration(value, "us") == Converter::microseconds{ value });
+    REQUIRE(Converter::ToDuration(value, "ms") == Converter::milliseconds{ value });
+    REQUIRE(Converter::ToDuration(value, "s") == Converter::seconds{ value });
+    REQUIRE(Converter::ToDuration(value, "m") == Converter::minutes{ value });
+    REQUIRE(Converter::ToDuration(value, "h") == Converter::hours{ value });
+    REQUIRE(Converter::ToDuration(value, "d") == Converter::days{ value });
+    REQUIRE(Converter::ToDuration(value, "y") == Converter::years{ value });
+    REQUIRE(Converter::ToDuration(value, "ky") == Converter::kiloyears{ value });
+    REQUIRE(Converter::ToDuration(value, "My") == Converter::millionyears{ value });
+    REQUIRE(Converter::ToDuration(value, "Gy") == Converter::billionyears{ value });
+    REQUIRE(Converter::ToDuration(value, "Ty") == Converter::billionyears{ 1.0e3 * value });
+    REQUIRE(Converter::ToDuration(value, "Py") == Converter::billionyears{ 1.0e6 * value });
+    REQUIRE(Converter::ToDuration(value, "Ey") == Converter::billionyears{ 1.0e9 * value });
+    REQUIRE(Converter::ToDuration(value, "Zy") == Converter::billionyears{ 1.0e12 * value });
+    REQUIRE(Converter::ToDuration(value, "Yy") == Converter::billionyears{ 1.0e15 * value });
+  }
+
+  SECTION("Unknown units are treated as stable")
+  {
+    REQUIRE(Converter::ToTimeUnit("") == Converter::TimeUnit::UNKNOWN);
+    REQUIRE(Converter::ToTimeUnit("ks") == Converter::TimeUnit::UNKNOWN);
+    REQUIRE(Converter::ToTimeUnit("ms ") == Converter::TimeUnit::UNKNOWN);
+    REQUIRE(Converter::ToTimeUnit("stbl") == Converter::TimeUnit::UNKNOWN);
+    REQUIRE(Converter::ToDuration(value, "xx") == Converter::seconds{ 1.0e24 });
+  }
+
+  SECTION("Only the characters in the view are read")
+  {
+    constexpr std::string_view unit{ "msec" };
+    REQUIRE(Converter::ToTimeUnit(unit.substr(0, 2)) == Converter::TimeUnit::MILLISECONDS);
+    REQUIRE(Converter::ToTimeUnit(unit.substr(0, 1)) == Converter::TimeUnit::MINUTES);
+  }
+
+  SECTION("Columns of values")
+  {
+    constexpr std::array<double, 4> values{ 1.0, 2.0, 3.0, 4.0 };
+    constexpr std::array<Converter::TimeUnit, 4> units{ Converter::TimeUnit::MILLISECONDS,
+                                                        Converter::TimeUnit::HOURS,
+                                                        Converter::TimeUnit::UNKNOWN,
+                                                        Converter::TimeUnit::TERAYEARS };
+    std::array<double, 4> seconds{};
+
+    REQUIRE(Converter::ToSeconds(values, units, seconds) == values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+      {
+        REQUIRE(Converter::seconds{ seconds.at(i) } == Converter::ToDuration(values.at(i), units.at(i)));
+      }
+
+    // The shortest input decides how many are converted
+    std::array<double, 2> short_output{};
+    REQUIRE(Converter::ToSeconds(values, units, short_output) == short_output.size());
+  }
+}
+
+
 TEST_CASE("Trim a string", "[Converter]")
 {
   SECTION("Leading")
@@ -0,0 +1,174 @@
+#include "nuclear-data-reader/derived_quantities.hpp"
+#include "nuclear-data-reader/field_mask.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+
+TEST_CASE("Formulae of the quantities", "[DerivedQuantities]")
+{
+  REQUIRE(DerivedQuantities::formula(Quantity::HALF_LIFE).empty());
+  REQUIRE(DerivedQuantities::formula(Quantity::AME_MASS_EXCESS).empty());
+
+  for (const auto quantity : reaction_1_quantities)
+    {
+      REQUIRE_FALSE(DerivedQuantities::formula(quantity).empty());
+    }
+  for (const auto quantity : reaction_2_quantities)
+    {
+      REQUIRE_FALSE(DerivedQuantities::formula(quantity).empty());
+    }
+}
+
+
+TEST_CASE("Calculate quantities from the masses", "[DerivedQuantities]")
+{
+  MassTable table(2020);
+  table.diagnostics.silence();
+  REQUIRE(table.populateInternalMassTable());
+
+  const DerivedQuantities derived(table);
+  REQUIRE(derived.getZmax() == 118);
+  REQUIRE(derived.getNmax() == 177);
+
+  SECTION("Separation energies")
+  {
+    const auto s_n = derived.calculate(Quantity::S_N);
+    REQUIRE(s_n.has_value());
+
+    const auto oxygen = derived.at(s_n.value(), 8, 11);
+    REQUIRE(oxygen.has_value());
+    REQUIRE_THAT(oxygen->amount, Catch::Matchers::WithinAbs(3955.6439, 0.001));
+    REQUIRE(oxygen->uncertainty.value() > 0.0);
+
+    // The neutron has nothing to separate from
+    REQUIRE_FALSE(derived.at(s_n.value(), 0, 1).has_value());
+    REQUIRE_FALSE(derived.at(s_n.value(), 200, 1).has_value());
+  }
+
+  SECTION("Custom formulae")
+  {
+    // Only the isotope itself gives back the mass excess
+    const std::array<DerivedQuantities::Term, 1> itself{ { { 0, 0, 1 } } };
+    const auto mass_excess = derived.calculate(itself);
+    REQUIRE(mass_excess.has_value());
+    REQUIRE_THAT(derived.at(mass_excess.value(), 8, 11)->amount, Catch::Matchers::WithinAbs(3332.858, 0.001));
+
+    // Difference between the masses of the neutron and hydrogen atom
+    const std::array<DerivedQuantities::Term, 2> fixed{ { { 0, 1, 1, false }, { 1, 0, -1, false } } };
+    const auto difference = derived.calculate(fixed);
+    REQUIRE(difference.has_value());
+    REQUIRE_THAT(derived.at(difference.value(), 50, 50)->amount, Catch::Matchers::WithinAbs(782.347, 0.001));
+
+    const std::array<DerivedQuantities::Term, 1> too_far{ { { DerivedQuantities::REACH + 1, 0, 1 } } };
+    REQUIRE_FALSE(derived.calculate(too_far).has_value());
+    REQUIRE_FALSE(derived.calculate(std::vector<DerivedQuantities::Term>{}).has_value());
+    REQUIRE_FALSE(derived.calculate(Quantity::HALF_LIFE).has_value());
+  }
+
+  SECTION("Agree with the reaction files")
+  {
+    REQUIRE(derived.crossCheck(table, Quantity::S_N).empty());
+    REQUIRE(derived.crossCheck(table, Quantity::S_2P).empty());
+    REQUIRE(derived.crossCheck(table, Quantity::Q_4BM).empty());
+    REQUIRE(derived.crossCheck(table, Quantity::Q_NA).empty());
+    REQUIRE(derived.crossCheck(table, Quantity::HALF_LIFE).empty());
+  }
+}
+
+
+TEST_CASE("Indicators of nuclear structure", "[DerivedQuantities]")
+{
+  MassTable table(2020);
+  table.diagnostics.silence();
+  REQUIRE(table.populateInternalMassTable());
+
+  const DerivedQuantities derived(table);
+  using Indicator = DerivedQuantities::Indicator;
+
+  SECTION("Pairing gaps are positive for odd and even nuclei")
+  {
+    const auto gap = derived.calculate(Indicator::PAIRING_GAP_3N);
+    REQUIRE(gap.has_value());
+    REQUIRE_THAT(derived.at(gap.value(), 50, 70)->amount, Catch::Matchers::WithinAbs(1466.9355, 0.001));
+    REQUIRE_THAT(derived.at(gap.value(), 50, 71)->amount, Catch::Matchers::WithinAbs(1322.2210, 0.001));
+    REQUIRE(derived.at(gap.value(), 50, 71)->uncertainty.value() > 0.0);
+
+    const auto wide = derived.calculate(Indicator::PAIRING_GAP_5P);
+    REQUIRE(wide.has_value());
+    REQUIRE(derived.at(wide.value(), 50, 70)->amount > 0.0);
+    REQUIRE(derived.at(wide.value(), 51, 70)->amount > 0.0);
+
+    // There is nothing beyond the heaviest element
+    REQUIRE_FALSE(derived.at(wide.value(), 117, 176).has_value());
+  }
+
+  SECTION("Shell gaps peak at the magic numbers")
+  {
+    const auto gap = derived.calculate(Indicator::SHELL_GAP_2N);
+    REQUIRE(gap.has_value());
+    REQUIRE_THAT(derived.at(gap.value(), 82, 126)->amount, Catch::Matchers::WithinAbs(4983.1030, 0.001));
+    REQUIRE(derived.at(gap.value(), 82, 126)->amount > 5 * derived.at(gap.value(), 82, 120)->amount);
+
+    const auto slope = derived.calculate(Indicator::S2N_DERIVATIVE);
+    REQUIRE(slope.has_value());
+    REQUIRE(derived.at(slope.value(), 82, 126)->amount < 0.0);
+  }
+
+  SECTION("The proton-neutron interaction is stored in the table")
+  {
+    const auto dV_pn = derived.calculate(Indicator::DELTA_VPN);
+    REQUIRE(dV_pn.has_value());
+
+    // Even-even nuclei use steps of 2 in both Z and N
+    const std::array<DerivedQuantities::Term, 4> even{ { { 0, 0, -1 }, { 0, -2, 1 }, { -2, 0, 1 }, { -2, -2, -1 } } };
+    const auto lead = derived.at(derived.calculate(even).value(), 82, 126);
+    REQUIRE_THAT(derived.at(dV_pn.value(), 82, 126)->amount, Catch::Matchers::WithinAbs(lead->amount / 4, 1.0e-9));
+    REQUIRE_THAT(derived.at(dV_pn.value(), 82, 126)->uncertainty.value(),
+                 Catch::Matchers::WithinAbs(lead->uncertainty.value() / 4, 1.0e-9));
+
+    for (const auto& ame : table.ameDataTable)
+      {
+        const auto expected = derived.at(dV_pn.value(), ame.Z, ame.N);
+        if (expected)
+          {
+            REQUIRE_THAT(ame.dV_pn.amount, Catch::Matchers::WithinAbs(expected->amount, 1.0e-9));
+          }
+        else
+          {
+            REQUIRE(Number::isMissing(ame.dV_pn.amount));
+          }
+      }
+
+    // The merged table is a copy, so has the values too
+    REQUIRE(std::any_of(table.fullDataTable.cbegin(), table.fullDataTable.cend(), [](const auto& isotope) {
+      return isotope.ame.Z == 10 && isotope.ame.N == 10 && std::fabs(isotope.ame.dV_pn.amount - 4078.4338) < 0.001;
+    }));
+  }
+}
+
+
+TEST_CASE("Masses that were not read are not used", "[DerivedQuantities]")
+{
+  MassTable table(2020);
+  table.diagnostics.silence();
+  table.fields = FieldMask{ { Quantity::HALF_LIFE } };
+  REQUIRE(table.populateInternalMassTable());
+
+  const DerivedQuantities derived(table);
+  const auto s_n = derived.calculate(Quantity::S_N);
+  REQUIRE(s_n.has_value());
+  REQUIRE_FALSE(derived.at(s_n.value(), 8, 11).has_value());
+
+  REQUIRE(std::none_of(table.ameDataTable.cbegin(), table.ameDataTable.cend(), [](const auto& ame) {
+    return !Number::isMissing(ame.dV_pn.amount);
+  }));
+}
@@ -0,0 +1,91 @@
+#include "nuclear-data-reader/diagnostics.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+  /// Keep everything that is reported, copying the text as it is only valid during report()
+  class RecordingSink final : public DiagnosticSink
+  {
+  public:
+    void report(const Diagnostic& diagnostic) override
+    {
+      diagnostics.push_back(diagnostic);
+      messages.emplace_back(diagnostic.message);
+    }
+
+    std::vector<Diagnostic> diagnostics;
+    std::vector<std::string> messages;
+  };
+} // namespace
+
+
+TEST_CASE("Send messages to a sink", "[Diagnostics]")
+{
+  RecordingSink recorder;
+  Diagnostics diagnostics;
+  diagnostics.sink = &recorder;
+
+  const std::filesystem::path file{ "rct1.mas20" };
+
+  diagnostics.report({ Severity::WARNING, DiagnosticCode::NO_MATCHING_ISOTOPE, &file, 42, 100, 50 },
+                     []() { return std::string("No match"); });
+
+  REQUIRE(recorder.diagnostics.size() == 1);
+  const auto& record = recorder.diagnostics.front();
+  REQUIRE(record.severity == Severity::WARNING);
+  REQUIRE(record.code == DiagnosticCode::NO_MATCHING_ISOTOPE);
+  REQUIRE(record.file == &file);
+  REQUIRE(record.line_number == 42);
+  REQUIRE(record.A == 100);
+  REQUIRE(record.Z == 50);
+  REQUIRE(recorder.messages.front() == "No match");
+  REQUIRE(diagnostics.count(Severity::WARNING) == 1);
+}
+
+
+TEST_CASE("Only count messages that are not wanted", "[Diagnostics]")
+{
+  RecordingSink recorder;
+  Diagnostics diagnostics;
+  diagnostics.sink = &recorder;
+
+  bool formatted{ false };
+  const auto message = [&formatted]() {
+    formatted = true;
+    return std::string("Progress");
+  };
+
+  SECTION("Below the threshold")
+  {
+    diagnostics.threshold = Severity::WARNING;
+    diagnostics.report({ Severity::INFO, DiagnosticCode::PROGRESS }, message);
+
+    REQUIRE_FALSE(diagnostics.accepts(Severity::INFO));
+    REQUIRE(diagnostics.accepts(Severity::ERROR));
+    REQUIRE_FALSE(formatted);
+    REQUIRE(recorder.diagnostics.empty());
+    REQUIRE(diagnostics.count(Severity::INFO) == 1);
+  }
+
+  SECTION("Silent")
+  {
+    Diagnostics silent;
+    silent.silence();
+    silent.report({ Severity::INFO, DiagnosticCode::PROGRESS }, message);
+
+    REQUIRE_FALSE(silent.accepts(Severity::ERROR));
+    REQUIRE_FALSE(formatted);
+    REQUIRE(silent.count(Severity::INFO) == 1);
+    REQUIRE(silent.count(Severity::ERROR) == 0);
+
+    // Copies keep the counts
+    const auto copy = silent;
+    REQUIRE(copy.count(Severity::INFO) == 1);
+  }
+}
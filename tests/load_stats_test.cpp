@@ -0,0 +1,83 @@
+#include "nuclear-data-reader/load_stats.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+
+namespace
+{
+  /// Pretend that 2 allocations, of 8 bytes each, are made between every call
+  AllocationCount fakeProbe() noexcept
+  {
+    static uint64_t calls{ 0 };
+    ++calls;
+    return { 2 * calls, 16 * calls };
+  }
+} // namespace
+
+
+TEST_CASE("Access the stats of a phase", "[LoadStats]")
+{
+  LoadStats stats;
+
+  stats[LoadPhase::NUBASE].records = 10;
+  stats[LoadPhase::NUBASE].addLine(5);
+  stats[LoadPhase::NUBASE].addLine(7);
+
+  const auto& const_stats = stats;
+  REQUIRE(const_stats[LoadPhase::NUBASE].records == 10);
+  REQUIRE(const_stats[LoadPhase::NUBASE].lines_read == 2);
+  REQUIRE(const_stats[LoadPhase::NUBASE].bytes_read == 12);
+  REQUIRE(const_stats[LoadPhase::MERGE].records == 0);
+
+  REQUIRE(LoadStats::name(LoadPhase::AME_MASS) == "AME mass");
+  REQUIRE(LoadStats::name(LoadPhase::MERGE) == "merge");
+}
+
+
+TEST_CASE("Time a phase", "[LoadStats]")
+{
+  LoadStats stats;
+
+  {
+    const LoadStats::Timer timer(stats[LoadPhase::MERGE]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  const auto first = stats[LoadPhase::MERGE].wall_time;
+  REQUIRE(first >= std::chrono::milliseconds(2));
+
+  // Time is added, not replaced
+  {
+    const LoadStats::Timer timer(stats[LoadPhase::MERGE]);
+  }
+  REQUIRE(stats[LoadPhase::MERGE].wall_time >= first);
+  REQUIRE(stats.totalWallTime() == stats[LoadPhase::MERGE].wall_time);
+}
+
+
+TEST_CASE("Count allocations in a phase", "[LoadStats]")
+{
+  LoadStats stats;
+
+  SECTION("Nothing is counted without a probe")
+  {
+    {
+      const LoadStats::Timer timer(stats[LoadPhase::NUBASE]);
+    }
+    REQUIRE(stats[LoadPhase::NUBASE].allocations == 0);
+    REQUIRE(stats[LoadPhase::NUBASE].allocated_bytes == 0);
+  }
+
+  SECTION("The difference between the start and end is counted")
+  {
+    {
+      const LoadStats::Timer timer(stats[LoadPhase::NUBASE], fakeProbe);
+    }
+    REQUIRE(stats[LoadPhase::NUBASE].allocations == 2);
+    REQUIRE(stats[LoadPhase::NUBASE].allocated_bytes == 16);
+    REQUIRE(stats[LoadPhase::MERGE].allocations == 0);
+  }
+}
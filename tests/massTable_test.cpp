@@ -1,9 +1,23 @@
+#include "nuclear-data-reader/field_mask.hpp"
 #include "nuclear-data-reader/massTable.hpp"
 #include "nuclear-data-reader/nubase_data.hpp"
+#include "nuclear-data-reader/nubase_decay_mode.hpp"
+#include "nuclear-data-reader/nuclide_key.hpp"
+#include "nuclear-data-reader/number.hpp"
+#include "nuclear-data-reader/quantity.hpp"
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_all.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
 
 TEST_CASE("Construct an instance", "[MassTable]")
 {
@@ -179,6 +193,22 @@ TEST_CASE("Try to read non-existent file", "[MassTable]")
 }
 
 
+TEST_CASE("Messages go to the table's diagnostics", "[MassTable]")
+{
+  MassTable table(2003);
+  table.setFilePaths();
+  table.diagnostics.silence();
+
+  const std::filesystem::path missing{ "doesnot.exist" };
+  REQUIRE_FALSE(table.readAMEMassFile(missing));
+  REQUIRE(table.diagnostics.count(Severity::ERROR) == 1);
+
+  REQUIRE(table.readAMEMassFile(table.AME_masstable));
+  REQUIRE(table.diagnostics.count(Severity::WARNING) == 0);
+  REQUIRE(table.diagnostics.count(Severity::INFO) > 0);
+}
+
+
 TEST_CASE("Read the NUBASE file", "[MassTable]")
 {
   SECTION("File instance with no header")
@@ -199,6 +229,79 @@ TEST_CASE("Read the NUBASE file", "[MassTable]")
 }
 
 
+TEST_CASE("Every decay branch is read", "[MassTable]")
+{
+  MassTable table(2020);
+  table.setFilePaths();
+
+  REQUIRE(table.readNUBASE(table.NUBASE_masstable));
+  REQUIRE(table.decay_branches.size() == table.nubaseDataTable.size());
+
+  // 212Po: A=100
+  const auto branches = table.getDecayBranches(212, 84);
+  REQUIRE(branches.size() == 1);
+  REQUIRE(branches.front().mode == NUBASE::DecayMode::common("A"));
+  REQUIRE(branches.front().ratio.amount == Catch::Approx(100.0));
+
+  REQUIRE(table.getDecayBranches(300, 200).empty());
+}
+
+
+TEST_CASE("Isomers are stored with their ground state", "[MassTable]")
+{
+  MassTable table(2020);
+  table.setFilePaths();
+
+  REQUIRE(table.readNUBASE(table.NUBASE_masstable));
+
+  const auto hafnium = std::find_if(table.nubaseDataTable.cbegin(), table.nubaseDataTable.cend(), [](const auto& iso) {
+    return iso.A == 178 && iso.Z == 72;
+  });
+  REQUIRE(hafnium != table.nubaseDataTable.cend());
+  REQUIRE(hafnium->isomer_count == 3);
+
+  const auto states = table.isomers.statesOf(*hafnium);
+  REQUIRE(states.size() == 3);
+  REQUIRE(states[1].level == 2);
+  REQUIRE(states[1].energy == Catch::Approx(2446.09));
+}
+
+
+TEST_CASE("Record what happened during the load", "[MassTable]")
+{
+  MassTable table(2020);
+  REQUIRE(table.populateInternalMassTable());
+
+  const auto& stats = table.load_stats;
+
+  const auto& ame = stats[LoadPhase::AME_MASS];
+  REQUIRE(ame.records == table.ameDataTable.size());
+  REQUIRE(ame.lines_read == ame.lines_skipped + ame.records);
+  REQUIRE(ame.bytes_read > 0);
+
+  const auto& nubase = stats[LoadPhase::NUBASE];
+  REQUIRE(nubase.records == table.nubaseDataTable.size());
+  REQUIRE(stats.isomers_attached == table.isomers.size());
+  REQUIRE(nubase.lines_read == nubase.lines_skipped + nubase.records + stats.isomers_attached + nubase.unmatched);
+
+  REQUIRE(stats[LoadPhase::MERGE].records == table.fullDataTable.size());
+  REQUIRE(stats[LoadPhase::AME_REACTION_1].records > 0);
+  REQUIRE(stats.totalWallTime() > std::chrono::nanoseconds{ 0 });
+
+  SECTION("Reloading starts again")
+  {
+    table.fullDataTable.clear();
+    table.ameDataTable.clear();
+    table.nubaseDataTable.clear();
+    table.isomers.clear();
+    table.decay_branches.clear();
+
+    REQUIRE(table.populateInternalMassTable());
+    REQUIRE(table.load_stats[LoadPhase::MERGE].records == table.fullDataTable.size());
+  }
+}
+
+
 TEST_CASE("Read the AME mass file", "[MassTable]")
 {
   const MassTable table(2003);
@@ -431,18 +534,18 @@ TEST_CASE("Read the NUBASE format", "[MassTable]")
     REQUIRE(nubase.A == 189);
     REQUIRE(nubase.Z == 81);
     REQUIRE(nubase.N == 108);
-    REQUIRE_THAT(nubase.symbol, Catch::Matchers::Matches("Tl"));
+    REQUIRE(nubase.symbol.str() == "Tl");
     REQUIRE(nubase.level == 0);
     REQUIRE(nubase.mass_excess.amount == Catch::Approx(-24602.0));
     REQUIRE(nubase.mass_excess.uncertainty.value() == Catch::Approx(11.0));
-    REQUIRE_THAT(nubase.halflife_unit, Catch::Matchers::Matches("m"));
+    REQUIRE(nubase.halflife_unit == Converter::TimeUnit::MINUTES);
     REQUIRE(nubase.hl == Converter::minutes{ 2.3 });
     REQUIRE(nubase.hl_error == Converter::minutes{ 0.2 });
     REQUIRE(nubase.J == Catch::Approx(0.5));
     REQUIRE(nubase.J_exp == NUBASE::Measured::THEORETICAL);
     REQUIRE(nubase.pi == NUBASE::Parity::POSITIVE);
     REQUIRE(nubase.pi_exp == NUBASE::Measured::THEORETICAL);
-    REQUIRE_FALSE(nubase.decay.compare("B+"));
+    REQUIRE(nubase.decay.str() == "B+");
   }
 
   SECTION("2003 first isomeric state")
@@ -456,7 +559,7 @@ TEST_CASE("Read the NUBASE format", "[MassTable]")
     REQUIRE(nubase.A == 18);
     REQUIRE(nubase.Z == 9);
     REQUIRE(nubase.N == 9);
-    REQUIRE_THAT(nubase.symbol, Catch::Matchers::Matches("F"));
+    REQUIRE(nubase.symbol.str() == "F");
     REQUIRE(nubase.level == 1);
   }
 
@@ -472,18 +575,18 @@ TEST_CASE("Read the NUBASE format", "[MassTable]")
     REQUIRE(nubase.A == 124);
     REQUIRE(nubase.Z == 50);
     REQUIRE(nubase.N == 74);
-    REQUIRE_THAT(nubase.symbol, Catch::Matchers::Matches("Sn"));
+    REQUIRE(nubase.symbol.str() == "Sn");
     REQUIRE(nubase.level == 0);
     REQUIRE(nubase.mass_excess.amount == Catch::Approx(-88236.8));
     REQUIRE(nubase.mass_excess.uncertainty.value() == Catch::Approx(1.4));
-    REQUIRE_THAT(nubase.halflife_unit, Catch::Matchers::Matches(""));
+    REQUIRE(nubase.halflife_unit == Converter::TimeUnit::UNKNOWN);
     REQUIRE(nubase.hl == Converter::seconds{ 1.0e24 });
     REQUIRE(nubase.hl_error == Converter::seconds{ 1.0 });
     REQUIRE(nubase.J == Catch::Approx(0.0));
     REQUIRE(nubase.J_exp == NUBASE::Measured::EXPERIMENTAL);
     REQUIRE(nubase.pi == NUBASE::Parity::POSITIVE);
     REQUIRE(nubase.pi_exp == NUBASE::Measured::EXPERIMENTAL);
-    REQUIRE_FALSE(nubase.decay.compare("stable"));
+    REQUIRE(nubase.decay.str() == "stable");
     REQUIRE(table.neutron_rich.at(50));
   }
 
@@ -510,7 +613,7 @@ TEST_CASE("Read the NUBASE format", "[MassTable]")
 
     const auto nubase = table.parseNUBASEFormat(line);
 
-    REQUIRE_THAT(nubase.symbol, Catch::Matchers::Matches("Xx"));
+    REQUIRE(nubase.symbol.str() == "Xx");
   }
 }
 
@@ -577,3 +680,277 @@ TEST_CASE("Output a json file", "[MassTable]")
 
   REQUIRE(table.outputTableToJSON());
 }
+
+
+TEST_CASE("Output the isomers alongside the table", "[MassTable]")
+{
+  MassTable table(2016);
+  NUBASE::Data nubase_1("", 2016);
+  nubase_1.A = 50;
+  nubase_1.Z = 25;
+  table.nubaseDataTable.emplace_back(nubase_1);
+  AME::Data ame_1("", 2016);
+  ame_1.A = 50;
+  ame_1.Z = 25;
+  table.ameDataTable.emplace_back(ame_1);
+
+  table.isomers.add({ 50, 25, 1, 225.28, 0.07 });
+  table.isomers.link(table.nubaseDataTable);
+
+  [[maybe_unused]] const auto merged = table.mergeData();
+
+  SECTION("As text")
+  {
+    table.isomer_export = MassTable::IsomerExport::TEXT;
+    REQUIRE(table.outputTableToCSV());
+
+    std::ifstream csv("masstable_2016_isomers.csv");
+    std::string line;
+    REQUIRE(std::getline(csv, line));
+    REQUIRE(line == NUBASE::IsomerTable::writeCSVHeader());
+    REQUIRE(std::getline(csv, line));
+    REQUIRE(line == "50,25,1,225.2800,0.0700");
+    REQUIRE_FALSE(std::getline(csv, line));
+  }
+
+  SECTION("As binary")
+  {
+    table.isomer_export = MassTable::IsomerExport::BINARY;
+    REQUIRE(table.outputTableToJSON());
+
+    REQUIRE(std::filesystem::file_size("masstable_2016_isomers.bin")
+            == NUBASE::IsomerTable::writeBinaryHeader().size() + NUBASE::IsomerTable::BINARY_RECORD_SIZE);
+
+    // Every export writes the file
+    std::filesystem::remove("masstable_2016_isomers.bin");
+    REQUIRE(table.outputTableToCSV());
+    REQUIRE(std::filesystem::file_size("masstable_2016_isomers.bin")
+            == NUBASE::IsomerTable::writeBinaryHeader().size() + NUBASE::IsomerTable::BINARY_RECORD_SIZE);
+  }
+
+  SECTION("The file can't be written")
+  {
+    table.diagnostics.silence();
+    table.isomer_export = MassTable::IsomerExport::BINARY;
+
+    // A directory can't be opened as a file
+    std::filesystem::remove("masstable_2016_isomers.bin");
+    std::filesystem::create_directory("masstable_2016_isomers.bin");
+    REQUIRE_FALSE(table.outputTableToJSON());
+    REQUIRE(table.diagnostics.count(Severity::ERROR) == 1);
+    std::filesystem::remove("masstable_2016_isomers.bin");
+  }
+}
+
+
+TEST_CASE("Defer reading the reaction files", "[MassTable]")
+{
+  MassTable eager(2020);
+  REQUIRE(eager.populateInternalMassTable());
+
+  MassTable lazy(2020);
+  lazy.load_mode = MassTable::LoadMode::LAZY_REACTIONS;
+  REQUIRE(lazy.populateInternalMassTable());
+
+  SECTION("Reaction files are only registered")
+  {
+    REQUIRE(lazy.reaction_load.pending);
+    REQUIRE(lazy.fullDataTable.size() == eager.fullDataTable.size());
+  }
+
+  SECTION("Values not from the reaction files do not trigger a read")
+  {
+    REQUIRE(lazy.getQuantity(19, 8, Quantity::AME_MASS_EXCESS).value().amount == Catch::Approx(3332.858));
+    REQUIRE(lazy.reaction_load.pending);
+  }
+
+  SECTION("Asking for a reaction value reads the files")
+  {
+    REQUIRE(lazy.getQuantity(19, 8, Quantity::S_N).value().amount == Catch::Approx(3955.6439));
+    REQUIRE_FALSE(lazy.reaction_load.pending);
+    REQUIRE(lazy.fullDataTable.at(95).writeAsCSV() == eager.fullDataTable.at(95).writeAsCSV());
+  }
+
+  SECTION("Unknown isotope")
+  {
+    REQUIRE_FALSE(lazy.getQuantity(1, 100, Quantity::S_N).has_value());
+  }
+}
+
+
+TEST_CASE("A failed deferred read is reported to every caller", "[MassTable]")
+{
+  MassTable lazy(2020);
+  lazy.diagnostics.silence();
+  lazy.load_mode = MassTable::LoadMode::LAZY_REACTIONS;
+  REQUIRE(lazy.populateInternalMassTable());
+
+  lazy.AME_reaction_1 = lazy.AME_reaction_1.parent_path() / "missing.mas20";
+  const auto mass_line = lazy.fullDataTable.at(95).ame.full_data;
+
+  REQUIRE_FALSE(lazy.readDeferredReactions());
+  REQUIRE_FALSE(lazy.readDeferredReactions());
+  REQUIRE_FALSE(lazy.reaction_load.pending);
+
+  // Values from the file that could be read are still copied, without replacing the rest of the isotope
+  REQUIRE(lazy.getQuantity(19, 8, Quantity::S_N).value().amount == Catch::Approx(3955.6439));
+  REQUIRE(lazy.fullDataTable.at(95).ame.full_data == mass_line);
+}
+
+
+TEST_CASE("Reloading a lazy table defers the reaction files again", "[MassTable]")
+{
+  MassTable lazy(2020);
+  lazy.diagnostics.silence();
+  lazy.load_mode = MassTable::LoadMode::LAZY_REACTIONS;
+  REQUIRE(lazy.populateInternalMassTable());
+  REQUIRE(lazy.getQuantity(208, 82, Quantity::S_N).value().amount == Catch::Approx(7367.8686));
+
+  lazy.fullDataTable.clear();
+  lazy.ameDataTable.clear();
+  lazy.nubaseDataTable.clear();
+  lazy.isomers.clear();
+  lazy.decay_branches.clear();
+
+  REQUIRE(lazy.populateInternalMassTable());
+  REQUIRE(lazy.reaction_load.pending);
+  REQUIRE(lazy.getQuantity(208, 82, Quantity::S_N).value().amount == Catch::Approx(7367.8686));
+  REQUIRE_FALSE(lazy.reaction_load.pending);
+}
+
+
+TEST_CASE("Look up many isotopes at once", "[MassTable]")
+{
+  MassTable table(2020);
+  REQUIRE(table.populateInternalMassTable());
+
+  // Enough keys that the values fetched ahead of time are used
+  std::vector<NuclideKey> keys;
+  for (uint16_t Z = 1; Z <= 30; ++Z)
+    {
+      keys.emplace_back(2 * Z + 1, Z);
+    }
+  keys.emplace_back(1, 100);
+  keys.emplace_back(19, 8);
+
+  std::vector<const Isotope*> results(keys.size(), nullptr);
+  const auto found = table.lookupMany(keys, results);
+
+  REQUIRE(found == keys.size() - 1);
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      if (results[i] == nullptr)
+        {
+          REQUIRE(keys[i].Z() == 100);
+          continue;
+        }
+      REQUIRE(results[i]->ame.A == keys[i].A());
+      REQUIRE(results[i]->ame.Z == keys[i].Z());
+    }
+  REQUIRE(results.back()->getQuantity(Quantity::AME_MASS_EXCESS).amount == Catch::Approx(3332.858));
+
+  SECTION("Fewer results than keys")
+  {
+    std::vector<const Isotope*> first(2, nullptr);
+    REQUIRE(table.lookupMany(keys, first) == 2);
+    REQUIRE(first[1]->ame.Z == 2);
+  }
+}
+
+
+TEST_CASE("Only parse the wanted values", "[MassTable]")
+{
+  SECTION("NUBASE")
+  {
+    MassTable table(2003);
+    table.fields = FieldMask{ { Quantity::NUBASE_MASS_EXCESS, Quantity::HALF_LIFE } };
+
+    const std::string line{ "189 0810   189Tl  -24602       11                              2.3    m 0.2    (1/2+)   "
+                            "     99           B+=100" };
+
+    const auto nubase = table.parseNUBASEFormat(line);
+
+    REQUIRE(nubase.A == 189);
+    REQUIRE(nubase.Z == 81);
+    REQUIRE(nubase.mass_excess.amount == Catch::Approx(-24602.0));
+    REQUIRE(nubase.hl == Converter::minutes{ 2.3 });
+    // Default values as these were not read
+    REQUIRE(nubase.J == Catch::Approx(100.0));
+    REQUIRE(nubase.pi == NUBASE::Parity::UNKNOWN);
+    REQUIRE(nubase.decay.str().empty());
+    REQUIRE(nubase.rich == NUBASE::Richness::STABLE);
+
+    table.fields           = FieldMask{ { Quantity::AME_MASS_EXCESS } };
+    const auto no_halflife = table.parseNUBASEFormat(line);
+    REQUIRE(Number::isMissing(no_halflife.hl.count()));
+    REQUIRE(Number::isMissing(no_halflife.mass_excess.amount));
+  }
+
+  SECTION("AME mass file")
+  {
+    const std::string line{ "   9   20   11   31 Na    x   12654.768    211.321     7385.492    6.817 B-  15872.148  "
+                            "211.668  31 013585.452    226.862" };
+
+    MassTable table(2003);
+    table.fields = FieldMask{ { Quantity::ATOMIC_MASS } };
+
+    const auto data = table.parseAMEMassFormat(line);
+
+    REQUIRE(data.A == 31);
+    REQUIRE(data.Z == 11);
+    REQUIRE(data.atomic_mass.amount == Catch::Approx(13585.452));
+    // Marked as missing, rather than left as zero, as these were not read
+    REQUIRE(Number::isMissing(data.mass_excess.amount));
+    REQUIRE(Number::isMissing(data.mass_excess.uncertainty.value()));
+    REQUIRE(Number::isMissing(data.binding_energy_per_A.amount));
+    REQUIRE(Number::isMissing(data.beta_decay_energy.amount));
+    REQUIRE(Number::isMissing(data.s_n.amount));
+  }
+
+  SECTION("Reaction files are skipped if none of their values are wanted")
+  {
+    MassTable table(2020);
+    table.fields = FieldMask{ { Quantity::AME_MASS_EXCESS, Quantity::S_N } };
+    REQUIRE_FALSE(table.fields.wantsReactionOne());
+    REQUIRE(table.fields.wantsReactionTwo());
+
+    REQUIRE(table.populateInternalMassTable());
+
+    const auto& isotope = table.fullDataTable.at(95);
+    REQUIRE(isotope.ame.s_n.amount == Catch::Approx(3955.6439));
+    REQUIRE(Number::isMissing(isotope.ame.s_2n.amount));
+    REQUIRE(Number::isMissing(isotope.ame.s_2n.uncertainty.value()));
+  }
+
+  SECTION("Values that were not read are not mistaken for zero")
+  {
+    MassTable table(2020);
+    table.diagnostics.silence();
+    table.fields = FieldMask{ { Quantity::AME_MASS_EXCESS, Quantity::HALF_LIFE } };
+    REQUIRE(table.populateInternalMassTable());
+
+    REQUIRE(table.getQuantity(208, 82, Quantity::AME_MASS_EXCESS).has_value());
+    REQUIRE_FALSE(table.getQuantity(208, 82, Quantity::S_N).has_value());
+    REQUIRE_FALSE(table.getQuantity(208, 82, Quantity::BINDING_ENERGY_PER_A).has_value());
+    REQUIRE_FALSE(table.getQuantity(208, 82, Quantity::NUBASE_MASS_EXCESS).has_value());
+
+    const auto& isotope = table.fullDataTable.at(95);
+    REQUIRE(Number::isMissing(isotope.nubase.mass_excess.amount));
+
+    const auto json = isotope.writeAsJSON(false);
+    REQUIRE(json.find("\"NubaseMassExcess\":null,") != std::string::npos);
+    REQUIRE(json.find("\"SingleNeutronSeparationEnergy\":null,") != std::string::npos);
+    REQUIRE(json.find("\"BindingEnergyPerA\":null,") != std::string::npos);
+    REQUIRE(json.find("\"AMEMassExcess\":null,") == std::string::npos);
+  }
+
+  SECTION("Everything is wanted by default")
+  {
+    const FieldMask mask;
+    REQUIRE(std::all_of(
+        all_quantities.cbegin(), all_quantities.cend(), [&mask](const auto quantity) { return mask.wants(quantity); }));
+    REQUIRE(mask.wants(Property::SPIN_PARITY));
+    REQUIRE(mask.wants(Property::DECAY_MODE));
+    REQUIRE(mask.wants(Property::DISCOVERY_YEAR));
+  }
+}
@@ -3,6 +3,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_all.hpp>
 
+#include <limits>
+#include <string_view>
+
 
 // TEST_CASE("", "[Isotope]")
 //{
@@ -14,7 +17,7 @@ TEST_CASE("Set Symbol", "[NUBASEData]")
   NUBASE::Data gs03_isotope("", 2003);
 
   gs03_isotope.setSymbol("Pb");
-  REQUIRE_THAT(gs03_isotope.symbol, Catch::Matchers::Matches("Pb"));
+  REQUIRE(gs03_isotope.symbol.str() == "Pb");
 }
 
 
@@ -47,6 +50,7 @@ TEST_CASE("Set State", "[NUBASEData]")
     SECTION("An isomeric state is added to the correct ground state")
     {
       std::vector<NUBASE::Data> table;
+      NUBASE::IsomerTable isomers;
 
       const std::string gs03{ "010 0030   10Li    33051       15                              2.0   zs 0.5    (1-,2-)  "
                               "     99 94Yo01tj  n=100" };
@@ -66,11 +70,15 @@ TEST_CASE("Set State", "[NUBASEData]")
       isomer03_isotope.setZ();
       isomer03_isotope.setState();
 
-      isomer03_isotope.setIsomerData(table);
-      REQUIRE(table.front().energy_levels.size() == 1);
-      REQUIRE(table.front().energy_levels.front().energy == Catch::Approx(200));
-      REQUIRE(table.front().energy_levels.front().error == Catch::Approx(40));
-      REQUIRE(table.front().energy_levels.front().level == 1);
+      REQUIRE(isomer03_isotope.setIsomerData(table, isomers));
+      isomers.link(table);
+      REQUIRE(table.front().isomer_count == 1);
+
+      const auto states = isomers.statesOf(table.front());
+      REQUIRE(states.size() == 1);
+      REQUIRE(states.front().energy == Catch::Approx(200));
+      REQUIRE(states.front().error == Catch::Approx(40));
+      REQUIRE(states.front().level == 1);
     }
   }
 
@@ -98,6 +106,7 @@ TEST_CASE("Set State", "[NUBASEData]")
     SECTION("An isomeric state is added to the correct ground state")
     {
       std::vector<NUBASE::Data> table;
+      NUBASE::IsomerTable isomers;
 
       const std::string gs20{ "265 1080   265Hs  120900         24                                     1.96  ms 0.16   "
                               "3/2+#         99          1984 A~100;SF ?" };
@@ -118,11 +127,15 @@ TEST_CASE("Set State", "[NUBASEData]")
       isomer20_isotope.setZ();
       isomer20_isotope.setState();
 
-      isomer20_isotope.setIsomerData(table);
-      REQUIRE(table.front().energy_levels.size() == 1);
-      REQUIRE(table.front().energy_levels.front().energy == Catch::Approx(229));
-      REQUIRE(table.front().energy_levels.front().error == Catch::Approx(22));
-      REQUIRE(table.front().energy_levels.front().level == 1);
+      REQUIRE(isomer20_isotope.setIsomerData(table, isomers));
+      isomers.link(table);
+      REQUIRE(table.front().isomer_count == 1);
+
+      const auto states = isomers.statesOf(table.front());
+      REQUIRE(states.size() == 1);
+      REQUIRE(states.front().energy == Catch::Approx(229));
+      REQUIRE(states.front().error == Catch::Approx(22));
+      REQUIRE(states.front().level == 1);
     }
   }
 }
@@ -130,8 +143,10 @@ TEST_CASE("Set State", "[NUBASEData]")
 
 TEST_CASE("State object is created correctly", "[NUBASEData]")
 {
-  auto level = NUBASE::Data::State(0, 1.2345, 0.321);
+  const NUBASE::IsomerState level{ 10, 3, 0, 1.2345, 0.321 };
 
+  REQUIRE(level.A == 10);
+  REQUIRE(level.Z == 3);
   REQUIRE(level.level == 0);
   REQUIRE(level.energy == Catch::Approx(1.2345));
   REQUIRE(level.error == Catch::Approx(0.321));
@@ -229,81 +244,77 @@ TEST_CASE("Read and set measured or theoretical", "[NUBASEData]")
 }
 
 
-TEST_CASE("Clean complicated spin parity format ", "[NUBASEData]")
+TEST_CASE("Parse complicated spin parity format", "[NUBASEData]")
 {
+  // Take the field from the line, as setSpinParity() does
+  const auto check = [](const NUBASE::Data& iso,
+                        const double J,
+                        const NUBASE::Parity pi,
+                        const NUBASE::Measured measured) {
+    const std::string_view line{ iso.full_data };
+    const auto field       = line.substr(iso.position.START_SPIN, iso.position.END_SPIN - iso.position.START_SPIN);
+    const auto spin_parity = NUBASE::Data::parseSpinParity(field);
+    REQUIRE(spin_parity.has_value());
+    REQUIRE(spin_parity->J == Catch::Approx(J));
+    REQUIRE(spin_parity->pi == pi);
+    REQUIRE(spin_parity->J_exp == measured);
+    REQUIRE(spin_parity->pi_exp == measured);
+  };
+
   SECTION("2003")
   {
     SECTION("131I 2nd isomer")
     {
-      NUBASE::Data iso(
+      const NUBASE::Data iso(
           "131 0492   131Inn -64040       70      4100      70     BD   320     ms 60     (19/2+..23/2+)94  "
           "         B->99;B-n=0.028 5;IT<1",
           2003);
-      std::string jpi =
-          iso.full_data.substr(iso.position.START_SPIN, (iso.position.END_SPIN - iso.position.START_SPIN));
-      jpi.erase(std::remove_if(jpi.begin(), jpi.end(), ::isspace), jpi.end());
-      REQUIRE(iso.cleanSpinParityString(jpi) == "(19/2+)");
+      check(iso, 9.5, NUBASE::Parity::POSITIVE, NUBASE::Measured::THEORETICAL);
     }
 
     SECTION("118Rh")
     {
-      NUBASE::Data iso(
+      const NUBASE::Data iso(
           "118 0450   118Rh  -65140#     500#                           310     ms 30     (4-10)(+#)    97 "
           "00Jo18tjd B-=100",
           2003);
-      std::string jpi =
-          iso.full_data.substr(iso.position.START_SPIN, (iso.position.END_SPIN - iso.position.START_SPIN));
-      jpi.erase(std::remove_if(jpi.begin(), jpi.end(), ::isspace), jpi.end());
-      REQUIRE(iso.cleanSpinParityString(jpi) == "(4)(+#)");
+      check(iso, 4.0, NUBASE::Parity::POSITIVE, NUBASE::Measured::THEORETICAL);
     }
 
     SECTION("176Ta 1st isomer")
     {
-      NUBASE::Data iso(
+      const NUBASE::Data iso(
           "176 0731   176Tam -51270       30       103.0     1.0          1.1   ms 0.1    (+)           98  "
           "         IT=100",
           2003);
-      std::string jpi =
-          iso.full_data.substr(iso.position.START_SPIN, (iso.position.END_SPIN - iso.position.START_SPIN));
-      jpi.erase(std::remove_if(jpi.begin(), jpi.end(), ::isspace), jpi.end());
-      REQUIRE(iso.cleanSpinParityString(jpi) == "(0+)");
+      check(iso, 0.0, NUBASE::Parity::POSITIVE, NUBASE::Measured::THEORETICAL);
     }
 
     SECTION("71Se 1st isomer")
     {
-      NUBASE::Data iso(
+      const NUBASE::Data iso(
           "071 0341   71Sem  -63070       30        48.79    0.05         5.6   us 0.7    1/2- to 9/2-  93  "
           "         IT=100",
           2003);
-      std::string jpi =
-          iso.full_data.substr(iso.position.START_SPIN, (iso.position.END_SPIN - iso.position.START_SPIN));
-      jpi.erase(std::remove_if(jpi.begin(), jpi.end(), ::isspace), jpi.end());
-
-      REQUIRE(iso.cleanSpinParityString(jpi) == "1/2-");
+      check(iso, 0.5, NUBASE::Parity::NEGATIVE, NUBASE::Measured::EXPERIMENTAL);
     }
 
     SECTION("42Sc 5th isomer")
     {
-      NUBASE::Data iso(
+      const NUBASE::Data iso(
           "042 0215   42Scr  -26044.91     0.26   6076.33    0.08  RQ                     (1+ to 4+)    01  "
           "         IT=100",
           2003);
-      std::string jpi =
-          iso.full_data.substr(iso.position.START_SPIN, (iso.position.END_SPIN - iso.position.START_SPIN));
-      jpi.erase(std::remove_if(jpi.begin(), jpi.end(), ::isspace), jpi.end());
-      REQUIRE(iso.cleanSpinParityString(jpi) == "(1+)");
+      check(iso, 1.0, NUBASE::Parity::POSITIVE, NUBASE::Measured::THEORETICAL);
     }
 
     SECTION("142Ho")
     {
-      NUBASE::Data iso(
+      const NUBASE::Data iso(
           "142 0670   142Ho  -37470#     500#                           400     ms 100    (6 to 9)      02 "
           "B+~100;B+p=?;p~0",
           2003);
-      std::string jpi =
-          iso.full_data.substr(iso.position.START_SPIN, (iso.position.END_SPIN - iso.position.START_SPIN));
-      jpi.erase(std::remove_if(jpi.begin(), jpi.end(), ::isspace), jpi.end());
-      REQUIRE(iso.cleanSpinParityString(jpi) == "(6)");
+      check(iso, 6.0, NUBASE::Parity::UNKNOWN, NUBASE::Measured::THEORETICAL);
     }
   }
 
@@ -311,36 +322,29 @@ TEST_CASE("Clean complicated spin parity format ", "[NUBASEData]")
   {
     SECTION("38P")
     {
-      NUBASE::Data iso(
+      const NUBASE::Data iso(
           "038 0150   38P    -14670       90                            640     ms 140    (0- to 4-)    08  "
           "        1971 B-=100;B-n=12 5",
           2012);
-      std::string jpi =
-          iso.full_data.substr(iso.position.START_SPIN, (iso.position.END_SPIN - iso.position.START_SPIN));
-      jpi.erase(std::remove_if(jpi.begin(), jpi.end(), ::isspace), jpi.end());
-      REQUIRE(iso.cleanSpinParityString(jpi) == "(0-)");
+      check(iso, 0.0, NUBASE::Parity::NEGATIVE, NUBASE::Measured::THEORETICAL);
     }
 
     SECTION("118Agm")
     {
-      NUBASE::Data iso("118 0471W  118Agm -79508.0      2.5      45.79    0.09        ~0.1   us        0(-) to 2(-)  "
-                       "95          1989 IT=100",
-                       2012);
-      std::string jpi =
-          iso.full_data.substr(iso.position.START_SPIN, (iso.position.END_SPIN - iso.position.START_SPIN));
-      jpi.erase(std::remove_if(jpi.begin(), jpi.end(), ::isspace), jpi.end());
-      REQUIRE(iso.cleanSpinParityString(jpi) == "0(-)");
+      const NUBASE::Data iso(
+          "118 0471W  118Agm -79508.0      2.5      45.79    0.09        ~0.1   us        0(-) to 2(-)  "
+          "95          1989 IT=100",
+          2012);
+      check(iso, 0.0, NUBASE::Parity::NEGATIVE, NUBASE::Measured::THEORETICAL);
     }
 
     SECTION("35Sxi")
     {
-      NUBASE::Data iso("035 0168   35Sxi  -19691       10      9155      10     RQ              T=5/2  (1/2:9/2)+    "
-                       "11          1975",
-                       2012);
-      std::string jpi =
-          iso.full_data.substr(iso.position.START_SPIN, (iso.position.END_SPIN - iso.position.START_SPIN));
-      jpi.erase(std::remove_if(jpi.begin(), jpi.end(), ::isspace), jpi.end());
-      REQUIRE(iso.cleanSpinParityString(jpi) == "(1/2)+");
+      const NUBASE::Data iso(
+          "035 0168   35Sxi  -19691       10      9155      10     RQ              T=5/2  (1/2:9/2)+    "
+          "11          1975",
+          2012);
+      check(iso, 0.5, NUBASE::Parity::POSITIVE, NUBASE::Measured::THEORETICAL);
     }
   }
 
@@ -352,6 +356,61 @@ TEST_CASE("Clean complicated spin parity format ", "[NUBASEData]")
 }
 
 
+TEST_CASE("Parse the spin parity field", "[NUBASEData]")
+{
+  const auto check = [](const std::string_view field,
+                        const double J,
+                        const NUBASE::Parity pi,
+                        const NUBASE::Measured measured) {
+    const auto spin_parity = NUBASE::Data::parseSpinParity(field);
+    REQUIRE(spin_parity.has_value());
+    REQUIRE(spin_parity->J == Catch::Approx(J));
+    REQUIRE(spin_parity->pi == pi);
+    REQUIRE(spin_parity->J_exp == measured);
+    REQUIRE(spin_parity->pi_exp == measured);
+  };
+
+  SECTION("Single values")
+  {
+    check("3/2-         ", 1.5, NUBASE::Parity::NEGATIVE, NUBASE::Measured::EXPERIMENTAL);
+    check("10+*", 10.0, NUBASE::Parity::POSITIVE, NUBASE::Measured::EXPERIMENTAL);
+    check(">21/2", 10.5, NUBASE::Parity::UNKNOWN, NUBASE::Measured::EXPERIMENTAL);
+    check("(13/2+)", 6.5, NUBASE::Parity::POSITIVE, NUBASE::Measured::THEORETICAL);
+    check("5#(-)", 5.0, NUBASE::Parity::NEGATIVE, NUBASE::Measured::THEORETICAL);
+    check("(+)", 0.0, NUBASE::Parity::POSITIVE, NUBASE::Measured::THEORETICAL);
+  }
+
+  SECTION("Lists take the first value")
+  {
+    check("(1,2)-", 1.0, NUBASE::Parity::UNKNOWN, NUBASE::Measured::THEORETICAL);
+    check("1/2+,(3/2+)", 0.5, NUBASE::Parity::POSITIVE, NUBASE::Measured::THEORETICAL);
+    check("2-#,0+#", 2.0, NUBASE::Parity::NEGATIVE, NUBASE::Measured::THEORETICAL);
+  }
+
+  SECTION("Ranges take the first value")
+  {
+    check("(4-10)(+#)", 4.0, NUBASE::Parity::POSITIVE, NUBASE::Measured::THEORETICAL);
+    check("(1/2:9/2)+", 0.5, NUBASE::Parity::POSITIVE, NUBASE::Measured::THEORETICAL);
+    check("(19/2+..23/2+)", 9.5, NUBASE::Parity::POSITIVE, NUBASE::Measured::THEORETICAL);
+    check("1/2-to9/2-", 0.5, NUBASE::Parity::NEGATIVE, NUBASE::Measured::EXPERIMENTAL);
+    check("0(-)to2(-)", 0.0, NUBASE::Parity::NEGATIVE, NUBASE::Measured::THEORETICAL);
+  }
+
+  SECTION("Ignore the unused parts")
+  {
+    check("3/2+ T=1/2", 1.5, NUBASE::Parity::POSITIVE, NUBASE::Measured::EXPERIMENTAL);
+    check("0+ frg", 0.0, NUBASE::Parity::POSITIVE, NUBASE::Measured::EXPERIMENTAL);
+  }
+
+  SECTION("Nothing to parse")
+  {
+    REQUIRE_FALSE(NUBASE::Data::parseSpinParity("").has_value());
+    REQUIRE_FALSE(NUBASE::Data::parseSpinParity("high").has_value());
+    REQUIRE_FALSE(NUBASE::Data::parseSpinParity("()").has_value());
+  }
+}
+
+
 TEST_CASE("Set all spin and parity values to unknown", "[NUBASEData]")
 {
   NUBASE::Data iso("", 2003);
@@ -435,7 +494,7 @@ TEST_CASE("Read half-life unit", "[NUBASEData]")
 
     gs03_isotope.setHalfLifeUnit();
 
-    REQUIRE_THAT(gs03_isotope.halflife_unit, Catch::Matchers::Matches("My"));
+    REQUIRE(gs03_isotope.halflife_unit == Converter::TimeUnit::MILLIONYEARS);
   }
 
   SECTION("Post 2020")
@@ -447,7 +506,7 @@ TEST_CASE("Read half-life unit", "[NUBASEData]")
 
     gs20_isotope.setHalfLifeUnit();
 
-    REQUIRE_THAT(gs20_isotope.halflife_unit, Catch::Matchers::Matches("ns"));
+    REQUIRE(gs20_isotope.halflife_unit == Converter::TimeUnit::NANOSECONDS);
   }
 }
 
@@ -924,10 +983,10 @@ TEST_CASE("Read the major decay mode", "[NUBASEData]")
 
 
       gs03_isotope.setDecayMode();
-      REQUIRE_THAT(gs03_isotope.decay, Catch::Matchers::Matches("B-"));
+      REQUIRE(gs03_isotope.decay.str() == "B-");
 
       isomer03_isotope.setDecayMode();
-      REQUIRE_THAT(isomer03_isotope.decay, Catch::Matchers::Matches("IT"));
+      REQUIRE(isomer03_isotope.decay.str() == "IT");
     }
 
     SECTION("Convert guess into unknown")
@@ -937,7 +996,7 @@ TEST_CASE("Read the major decay mode", "[NUBASEData]")
                          2003 };
 
       data.setDecayMode();
-      REQUIRE_THAT(data.decay, Catch::Matchers::Matches("unknown"));
+      REQUIRE(data.decay.str() == "unknown");
     }
 
     SECTION("Convert e+ -> B+")
@@ -947,7 +1006,7 @@ TEST_CASE("Read the major decay mode", "[NUBASEData]")
                          2003 };
 
       data.setDecayMode();
-      REQUIRE_FALSE(data.decay.compare("B+"));
+      REQUIRE(data.decay.str() == "B+");
     }
 
     SECTION("Remove unwanted characters")
@@ -957,7 +1016,7 @@ TEST_CASE("Read the major decay mode", "[NUBASEData]")
                          2003 };
 
       data.setDecayMode();
-      REQUIRE_FALSE(data.decay.compare("B+"));
+      REQUIRE(data.decay.str() == "B+");
     }
   }
 
@@ -975,10 +1034,10 @@ TEST_CASE("Read the major decay mode", "[NUBASEData]")
 
 
       gs20_isotope.setDecayMode();
-      REQUIRE_THAT(gs20_isotope.decay, Catch::Matchers::Matches("EC"));
+      REQUIRE(gs20_isotope.decay.str() == "EC");
 
       isomer20_isotope.setDecayMode();
-      REQUIRE_THAT(isomer20_isotope.decay, Catch::Matchers::Matches("IT"));
+      REQUIRE(isomer20_isotope.decay.str() == "IT");
     }
 
     SECTION("Convert guess into unknown")
@@ -988,7 +1047,7 @@ TEST_CASE("Read the major decay mode", "[NUBASEData]")
                          2020 };
 
       data.setDecayMode();
-      REQUIRE_THAT(data.decay, Catch::Matchers::Matches("unknown"));
+      REQUIRE(data.decay.str() == "unknown");
     }
 
     // Scenario doesn't exist for the major decay mode in 2020 data
@@ -997,7 +1056,7 @@ TEST_CASE("Read the major decay mode", "[NUBASEData]")
     //  NUBASE::Data data{ "", 2020 };
     //
     //  data.setDecayMode();
-    //  REQUIRE_FALSE(data.decay.compare("B+"));
+    //  REQUIRE(data.decay.str() == "B+");
     //}
 
     SECTION("Remove unwanted characters")
@@ -1007,12 +1066,37 @@ TEST_CASE("Read the major decay mode", "[NUBASEData]")
                          2020 };
 
       data.setDecayMode();
-      REQUIRE_FALSE(data.decay.compare("SF"));
+      REQUIRE(data.decay.str() == "SF");
     }
   }
 }
 
 
+TEST_CASE("Lines that are too short to hold all values", "[NUBASEData]")
+{
+  // Only the A, Z and mass excess are present
+  NUBASE::Data data{ "224 0876   224Frx  21900#     100#", 2003 };
+
+  SECTION("Half-life is set as very short")
+  {
+    data.setHalfLife();
+    REQUIRE(data.hl == Converter::seconds{ 1.0e-24 });
+    REQUIRE(data.hl_error == Converter::seconds{ 1.0 });
+  }
+
+  SECTION("Decay mode is set as an isomer")
+  {
+    data.setDecayMode();
+    REQUIRE(data.decay.str() == "isomer?");
+  }
+
+  SECTION("Half-life error can't be read")
+  {
+    REQUIRE(data.getNumericalHalfLifeError() == Catch::Approx(std::numeric_limits<double>::max()));
+  }
+}
+
+
 TEST_CASE("Read the year", "[NUBASEData]")
 {
   SECTION("Pre 2020")
@@ -1250,7 +1334,7 @@ TEST_CASE("Set the neutron/proton rich value", "[NUBASEData]")
 
   SECTION("Stable")
   {
-    data.decay = "stable";
+    data.decay = NUBASE::DecayMode::common("stable");
     data.setNeutronOrProtonRich(true);
     REQUIRE(data.rich == NUBASE::Richness::STABLE);
   }
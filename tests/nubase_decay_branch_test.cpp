@@ -0,0 +1,93 @@
+#include "nuclear-data-reader/nubase_decay_branch.hpp"
+
+#include "nuclear-data-reader/nubase_decay_mode.hpp"
+#include "nuclear-data-reader/number.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+
+TEST_CASE("Parse a single decay branch", "[DecayBranch]")
+{
+  SECTION("Mode, ratio and uncertainty")
+  {
+    const auto branch = NUBASE::DecayBranchTable::parseBranch("B-n=0.58 12");
+
+    REQUIRE(branch.mode == NUBASE::DecayMode::common("B-n"));
+    REQUIRE(branch.qualifier == NUBASE::Qualifier::EQUAL);
+    REQUIRE(branch.ratio.amount == Catch::Approx(0.58));
+    REQUIRE(branch.ratio.uncertainty.value() == Catch::Approx(0.12));
+  }
+
+  SECTION("Isotopic abundance is converted to stable")
+  {
+    const auto branch = NUBASE::DecayBranchTable::parseBranch("IS=80.1 7");
+
+    REQUIRE(branch.mode == NUBASE::DecayMode::common("stable"));
+    REQUIRE(branch.ratio.amount == Catch::Approx(80.1));
+    REQUIRE(branch.ratio.uncertainty.value() == Catch::Approx(0.7));
+  }
+
+  SECTION("Ratio with an exponent")
+  {
+    const auto branch = NUBASE::DecayBranchTable::parseBranch("B-A=5.5e-5 2");
+
+    REQUIRE(branch.mode.str() == "B-A");
+    REQUIRE(branch.ratio.amount == Catch::Approx(5.5e-5));
+    REQUIRE(branch.ratio.uncertainty.value() == Catch::Approx(0.2e-5));
+  }
+
+  SECTION("Qualifiers")
+  {
+    REQUIRE(NUBASE::DecayBranchTable::parseBranch("A~100").qualifier == NUBASE::Qualifier::APPROXIMATE);
+    REQUIRE(NUBASE::DecayBranchTable::parseBranch("IT LE 0.05").qualifier == NUBASE::Qualifier::LESS_OR_EQUAL);
+    REQUIRE(NUBASE::DecayBranchTable::parseBranch("EC<3").qualifier == NUBASE::Qualifier::LESS);
+    REQUIRE(NUBASE::DecayBranchTable::parseBranch("B-n=? ").qualifier == NUBASE::Qualifier::UNKNOWN);
+
+    const auto branch = NUBASE::DecayBranchTable::parseBranch("p ?");
+    REQUIRE(branch.mode == NUBASE::DecayMode::common("p"));
+    REQUIRE(branch.qualifier == NUBASE::Qualifier::UNKNOWN);
+    REQUIRE(Number::isMissing(branch.ratio.amount));
+  }
+
+  SECTION("Continuation markers are not a mode")
+  {
+    REQUIRE(NUBASE::DecayBranchTable::parseBranch("...").mode == NUBASE::DecayMode{});
+  }
+}
+
+
+TEST_CASE("Table of decay branches", "[DecayBranch]")
+{
+  NUBASE::DecayBranchTable table;
+
+  REQUIRE(table.addIsotope("B-=81 2;IT=19 2") == 2);
+  table.addEmptyIsotope();
+  REQUIRE(table.addIsotope("A=100;...") == 1);
+
+  REQUIRE(table.size() == 3);
+
+  SECTION("Rows hold the branches of each isotope")
+  {
+    const auto first = table.branchesOf(0);
+    REQUIRE(first.size() == 2);
+    REQUIRE(first[0].mode == NUBASE::DecayMode::common("B-"));
+    REQUIRE(first[1].mode == NUBASE::DecayMode::common("IT"));
+    REQUIRE(first[1].ratio.amount == Catch::Approx(19.0));
+
+    REQUIRE(table.branchesOf(1).empty());
+    REQUIRE(table.branchesOf(2).size() == 1);
+  }
+
+  SECTION("Rows that do not exist are empty")
+  {
+    REQUIRE(table.branchesOf(3).empty());
+  }
+
+  SECTION("Clear the table")
+  {
+    table.clear();
+    REQUIRE(table.size() == 0);
+    REQUIRE(table.branches.empty());
+  }
+}
@@ -0,0 +1,72 @@
+#include "nuclear-data-reader/nubase_decay_mode.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("Common decay modes", "[DecayMode]")
+{
+  SECTION("Default is empty")
+  {
+    const NUBASE::DecayMode decay;
+    REQUIRE(decay.str().empty());
+    REQUIRE(decay == NUBASE::DecayMode::common(""));
+  }
+
+  SECTION("Runtime and compile time modes match")
+  {
+    REQUIRE(NUBASE::DecayMode("stable") == NUBASE::DecayMode::common("stable"));
+    REQUIRE(NUBASE::DecayMode("B-").str() == "B-");
+    REQUIRE_FALSE(NUBASE::DecayMode("B-") == NUBASE::DecayMode("B+"));
+  }
+}
+
+
+TEST_CASE("Uncommon decay modes", "[DecayMode]")
+{
+  SECTION("The same string gives the same id")
+  {
+    const NUBASE::DecayMode first("B-3n");
+    const NUBASE::DecayMode second(std::string_view{ "B-3nB-4n" }.substr(0, 4));
+
+    REQUIRE(first == second);
+    REQUIRE(first.value() >= NUBASE::DecayMode::common_modes.size());
+    REQUIRE(first.str() == "B-3n");
+  }
+
+  SECTION("Modes can be added from multiple threads")
+  {
+    constexpr std::array<std::string_view, 4> modes{ "2B+", "B+A", "B+2p", "B+3p" };
+
+    std::vector<std::thread> threads;
+    std::array<std::array<NUBASE::DecayMode, modes.size()>, 4> seen{};
+    for (auto& results : seen)
+      {
+        threads.emplace_back([&results, &modes]() {
+          for (std::size_t i = 0; i < modes.size(); ++i)
+            {
+              results.at(i) = NUBASE::DecayMode(modes.at(i));
+            }
+        });
+      }
+
+    for (auto& thread : threads)
+      {
+        thread.join();
+      }
+
+    for (const auto& results : seen)
+      {
+        REQUIRE(results == seen.front());
+        for (std::size_t i = 0; i < modes.size(); ++i)
+          {
+            REQUIRE(results.at(i).str() == modes.at(i));
+          }
+      }
+  }
+}
@@ -0,0 +1,92 @@
+#include "nuclear-data-reader/nubase_isomer_table.hpp"
+
+#include "nuclear-data-reader/nubase_data.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+
+TEST_CASE("Link isomers to their ground state", "[IsomerTable]")
+{
+  std::vector<NUBASE::Data> ground_states(3, NUBASE::Data("", 2020));
+  ground_states.at(0).A = 10;
+  ground_states.at(0).Z = 3;
+  ground_states.at(1).A = 12;
+  ground_states.at(1).Z = 6;
+  ground_states.at(2).A = 178;
+  ground_states.at(2).Z = 72;
+
+  NUBASE::IsomerTable isomers;
+  // Deliberately out of order
+  isomers.add({ 178, 72, 2, 2446.09, 0.10 });
+  isomers.add({ 10, 3, 1, 200.0, 40.0 });
+  isomers.add({ 178, 72, 1, 1147.416, 0.006 });
+
+  isomers.link(ground_states);
+
+  SECTION("States are sorted")
+  {
+    REQUIRE(isomers.size() == 3);
+    REQUIRE(isomers.states.front().A == 10);
+    REQUIRE(isomers.states.back().level == 2);
+  }
+
+  SECTION("Each ground state knows where its states are")
+  {
+    REQUIRE(ground_states.at(0).isomer_count == 1);
+    REQUIRE(ground_states.at(1).isomer_count == 0);
+    REQUIRE(isomers.statesOf(ground_states.at(1)).empty());
+
+    const auto states = isomers.statesOf(ground_states.at(2));
+    REQUIRE(states.size() == 2);
+    REQUIRE(states.front().level == 1);
+    REQUIRE(states.front().energy == Catch::Approx(1147.416));
+    REQUIRE(states.back().level == 2);
+  }
+
+  SECTION("An isotope that was not linked has no states")
+  {
+    isomers.clear();
+    REQUIRE(isomers.statesOf(ground_states.at(2)).empty());
+  }
+}
+
+
+TEST_CASE("Write a state", "[IsomerTable]")
+{
+  const NUBASE::IsomerState state{ 178, 72, 2, 2446.09, 0.10 };
+
+  SECTION("As csv")
+  {
+    REQUIRE(NUBASE::IsomerTable::writeAsCSV(state) == "178,72,2,2446.0900,0.1000");
+  }
+
+  SECTION("As json")
+  {
+    REQUIRE(NUBASE::IsomerTable::writeAsJSON(state)
+            == R"({"A":178,"Z":72,"Level":2,"Energy":2446.0900,"ErrorEnergy":0.1000})");
+  }
+
+  SECTION("As binary")
+  {
+    const auto header = NUBASE::IsomerTable::writeBinaryHeader();
+    REQUIRE(std::string_view(header.data(), 8) == "NDRISO01");
+
+    const auto record = NUBASE::IsomerTable::writeAsBinary(state);
+
+    uint16_t Z{ 0 };
+    double energy{ 0.0 };
+    std::memcpy(&Z, record.data() + 2, sizeof(Z));
+    std::memcpy(&energy, record.data() + 8, sizeof(energy));
+
+    REQUIRE(Z == 72);
+    REQUIRE(energy == Catch::Approx(2446.09));
+    REQUIRE(record.at(5) == 0);
+  }
+}
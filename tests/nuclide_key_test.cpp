@@ -0,0 +1,76 @@
+#include "nuclear-data-reader/nuclide_key.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+
+TEST_CASE("Pack and unpack a key", "[NuclideKey]")
+{
+  constexpr NuclideKey key(178, 72, 2);
+  REQUIRE(key.A() == 178);
+  REQUIRE(key.Z() == 72);
+  REQUIRE(key.N() == 106);
+  REQUIRE(key.level() == 2);
+  REQUIRE(key.bits == ((178U << NuclideKey::A_SHIFT) | (72U << NuclideKey::Z_SHIFT) | 2U));
+
+  REQUIRE(key.groundState() == NuclideKey(178, 72));
+  REQUIRE(NuclideKey::fromZN(72, 106, 2) == key);
+
+  SECTION("A smaller than Z")
+  {
+    constexpr NuclideKey impossible(1, 100);
+    REQUIRE(impossible.A() == 1);
+    REQUIRE(impossible.Z() == 100);
+    REQUIRE(impossible.N() > 1000);
+  }
+}
+
+
+TEST_CASE("Keys are ordered by A, Z and level", "[NuclideKey]")
+{
+  REQUIRE(NuclideKey(4, 2) < NuclideKey(5, 1));
+  REQUIRE(NuclideKey(5, 2) < NuclideKey(5, 3));
+  REQUIRE(NuclideKey(5, 2) < NuclideKey(5, 2, 1));
+  REQUIRE(NuclideKey(5, 2, 1) != NuclideKey(5, 2));
+
+  std::vector<NuclideKey> keys{ { 16, 8 }, { 4, 2, 1 }, { 1, 1 }, { 16, 7 }, { 4, 2 } };
+  auto by_bits = keys;
+
+  std::sort(keys.begin(), keys.end());
+  REQUIRE(keys == std::vector<NuclideKey>{ { 1, 1 }, { 4, 2 }, { 4, 2, 1 }, { 16, 7 }, { 16, 8 } });
+
+  SECTION("The packed value sorts the same way")
+  {
+    std::sort(by_bits.begin(), by_bits.end(), [](const auto lhs, const auto rhs) { return lhs.bits < rhs.bits; });
+    REQUIRE(by_bits == keys);
+  }
+}
+
+
+TEST_CASE("Hash keys", "[NuclideKey]")
+{
+  const std::hash<NuclideKey> hash;
+  REQUIRE(hash(NuclideKey(4, 2)) == hash(NuclideKey(4, 2)));
+  REQUIRE(hash(NuclideKey(4, 2)) != hash(NuclideKey(4, 2, 1)));
+
+  // Every isotope on the chart gets a different hash
+  std::unordered_set<std::size_t> hashes;
+  std::unordered_set<NuclideKey> keys;
+  for (uint16_t Z = 0; Z < 120; ++Z)
+    {
+      for (uint16_t N = 0; N < 180; ++N)
+        {
+          hashes.insert(hash(NuclideKey::fromZN(Z, N)));
+          keys.insert(NuclideKey::fromZN(Z, N));
+        }
+    }
+  REQUIRE(hashes.size() == 120 * 180);
+  REQUIRE(keys.size() == hashes.size());
+  REQUIRE(keys.contains(NuclideKey(16, 8)));
+}
@@ -0,0 +1,186 @@
+#include "nuclear-data-reader/query_engine.hpp"
+#include "nuclear-data-reader/query_protocol.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace
+{
+  constexpr std::array<uint16_t, 3> served_years{ 2020, 1997, 1900 };
+
+  constexpr uint32_t mass_and_sn{ Query::select(Quantity::AME_MASS_EXCESS) | Query::select(Quantity::S_N) };
+} // namespace
+
+
+TEST_CASE("Only valid years are served", "[QueryEngine]")
+{
+  const QueryEngine engine(served_years);
+  REQUIRE(engine.years() == std::vector<uint16_t>{ 2020, 1995 });
+}
+
+
+TEST_CASE("Nothing is answered before the tables are loaded", "[QueryEngine]")
+{
+  const QueryEngine engine(served_years);
+
+  std::vector<std::byte> input;
+  const std::array<Query::Nuclide, 1> nuclides{ { { 19, 8 } } };
+  Query::appendRequest<Query::Nuclide>(input, 7, 2020, mass_and_sn, nuclides);
+
+  std::vector<std::byte> output;
+  REQUIRE(engine.process(input, output) == input.size());
+
+  const auto header = Query::read<Query::ResponseHeader>(output, 0);
+  REQUIRE(header.tag == 7);
+  REQUIRE(header.status == Query::Status::NOT_LOADED);
+  REQUIRE(header.count == 0);
+  REQUIRE(output.size() == sizeof(Query::ResponseHeader));
+}
+
+
+TEST_CASE("Answer requests", "[QueryEngine]")
+{
+  QueryEngine engine(served_years);
+  REQUIRE(engine.load());
+
+  const std::array<Query::Nuclide, 3> nuclides{ { { 19, 8 }, { 1, 100 }, { 4, 2 } } };
+
+  std::vector<std::byte> lookup;
+  Query::appendRequest<Query::Nuclide>(lookup, 7, 2020, mass_and_sn, nuclides);
+
+  SECTION("Look up individual isotopes")
+  {
+    std::vector<std::byte> output;
+    REQUIRE(engine.process(lookup, output) == lookup.size());
+
+    const auto header   = Query::read<Query::ResponseHeader>(output, 0);
+    const auto row_size = Query::rowSize(mass_and_sn);
+    REQUIRE(header.tag == 7);
+    REQUIRE(header.status == Query::Status::OK);
+    REQUIRE(header.count == nuclides.size());
+    REQUIRE(header.payload_size == nuclides.size() * row_size);
+    REQUIRE(output.size() == sizeof(Query::ResponseHeader) + header.payload_size);
+
+    const auto first = sizeof(Query::ResponseHeader);
+    const auto row   = Query::read<Query::RowHeader>(output, first);
+    REQUIRE(row.N == 11);
+    REQUIRE(row.flags == Query::FOUND);
+    // Values are in the order of Quantity
+    const auto mass = Query::read<Query::Value>(output, first + sizeof(Query::RowHeader));
+    const auto s_n  = Query::read<Query::Value>(output, first + sizeof(Query::RowHeader) + sizeof(Query::Value));
+    REQUIRE(mass.amount == Catch::Approx(3332.858));
+    REQUIRE(s_n.amount == Catch::Approx(3955.6439));
+
+    const auto missing = Query::read<Query::RowHeader>(output, first + row_size);
+    REQUIRE(missing.A == 1);
+    REQUIRE(missing.Z == 100);
+    REQUIRE(missing.flags == 0);
+    REQUIRE(std::isnan(Query::read<Query::Value>(output, first + row_size + sizeof(Query::RowHeader)).amount));
+
+    REQUIRE(Query::read<Query::RowHeader>(output, first + 2 * row_size).flags == Query::FOUND);
+  }
+
+  SECTION("Values that are not known are sent as NaN")
+  {
+    // Hydrogen is in the table, but has no neutron to separate
+    std::vector<std::byte> input;
+    const std::array<Query::Nuclide, 1> hydrogen{ { { 1, 1 } } };
+    Query::appendRequest<Query::Nuclide>(input, 9, 2020, mass_and_sn, hydrogen);
+
+    std::vector<std::byte> output;
+    REQUIRE(engine.process(input, output) == input.size());
+
+    const auto first = sizeof(Query::ResponseHeader);
+    REQUIRE(Query::read<Query::RowHeader>(output, first).flags == Query::FOUND);
+
+    const auto mass = Query::read<Query::Value>(output, first + sizeof(Query::RowHeader));
+    const auto s_n  = Query::read<Query::Value>(output, first + sizeof(Query::RowHeader) + sizeof(Query::Value));
+    REQUIRE(mass.amount == Catch::Approx(7288.97106));
+    REQUIRE(std::isnan(s_n.amount));
+    REQUIRE(std::isnan(s_n.uncertainty));
+  }
+
+  SECTION("Every isotope in a region")
+  {
+    std::vector<std::byte> input;
+    const std::array<Query::Region, 2> regions{ { { 8, 8, 0, 200 }, { 2, 2, 2, 2 } } };
+    Query::appendRequest<Query::Region>(input, 8, 1997, Query::select(Quantity::HALF_LIFE), regions);
+
+    std::vector<std::byte> output;
+    REQUIRE(engine.process(input, output) == input.size());
+
+    const auto header = Query::read<Query::ResponseHeader>(output, 0);
+    REQUIRE(header.status == Query::Status::OK);
+    REQUIRE(header.count > 1);
+
+    const auto last = Query::read<Query::RowHeader>(
+        output, sizeof(Query::ResponseHeader) + (header.count - 1) * Query::rowSize(header.quantities));
+    REQUIRE(last.A == 4);
+    REQUIRE(last.Z == 2);
+  }
+
+  SECTION("Requests can be pipelined, and may arrive in pieces")
+  {
+    auto input = lookup;
+    Query::appendRequest<Query::Nuclide>(input, 9, 1900, mass_and_sn, nuclides);
+    const std::span<const std::byte> all(input);
+
+    // Only the first request is complete
+    std::vector<std::byte> output;
+    REQUIRE(engine.process(all.first(lookup.size() + 5), output) == lookup.size());
+    REQUIRE(engine.process(all.subspan(lookup.size()), output) == input.size() - lookup.size());
+
+    const auto second_at = sizeof(Query::ResponseHeader) + nuclides.size() * Query::rowSize(mass_and_sn);
+    const auto second    = Query::read<Query::ResponseHeader>(output, second_at);
+    REQUIRE(second.tag == 9);
+    REQUIRE(second.status == Query::Status::UNKNOWN_YEAR);
+    REQUIRE(output.size() == second_at + sizeof(Query::ResponseHeader));
+  }
+
+  SECTION("Responses are limited in size")
+  {
+    // Every region is the whole chart, so together they need more rows than can be sent
+    const std::vector<Query::Region> regions(100, Query::Region{ 0, 200, 0, 300 });
+    std::vector<std::byte> input;
+    Query::appendRequest<Query::Region>(input, 11, 2020, Query::ALL_QUANTITIES, regions);
+
+    std::vector<std::byte> output;
+    REQUIRE(engine.process(input, output) == input.size());
+    const auto header = Query::read<Query::ResponseHeader>(output, 0);
+    REQUIRE(header.status == Query::Status::BAD_REQUEST);
+    REQUIRE(header.count == 0);
+    REQUIRE(output.size() == sizeof(Query::ResponseHeader));
+
+    // Once the output reaches the limit the remaining requests are left in the input
+    auto pipelined = lookup;
+    Query::appendRequest<Query::Nuclide>(pipelined, 12, 2020, mass_and_sn, nuclides);
+    output.clear();
+    REQUIRE(engine.process(pipelined, output, 1) == lookup.size());
+    REQUIRE(Query::read<Query::ResponseHeader>(output, 0).tag == 7);
+  }
+
+  SECTION("Bad requests")
+  {
+    std::vector<std::byte> input;
+    Query::appendRequest<Query::Nuclide>(input, 10, 2020, Query::ALL_QUANTITIES + 1, nuclides);
+
+    std::vector<std::byte> output;
+    REQUIRE(engine.process(input, output) == input.size());
+    REQUIRE(Query::read<Query::ResponseHeader>(output, 0).status == Query::Status::BAD_REQUEST);
+
+    Query::RequestHeader too_big;
+    too_big.payload_size = Query::MAX_PAYLOAD_SIZE + 1;
+    input.clear();
+    Query::append(input, too_big);
+    REQUIRE_FALSE(engine.process(input, output).has_value());
+  }
+}
@@ -0,0 +1,122 @@
+#include "nuclear-data-reader/isotope.hpp"
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+#include "nuclear-data-reader/table_diff.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+TEST_CASE("Tables must be populated before comparing", "[TableDiff]")
+{
+  const MassTable before(2016);
+  const MassTable after(2020);
+  TableDiff diff;
+
+  REQUIRE_FALSE(diff.compare(before, after));
+  REQUIRE_FALSE(diff.outputDiffToCSV());
+}
+
+
+TEST_CASE("Compare two small tables", "[TableDiff]")
+{
+  MassTable before(2016);
+  MassTable after(2020);
+
+  const auto add_isotope = [](MassTable& table, const uint16_t A, const uint16_t Z, const Number mass_excess) {
+    AME::Data ame("", table.year);
+    ame.A           = A;
+    ame.Z           = Z;
+    ame.mass_excess = mass_excess;
+    table.fullDataTable.emplace_back(ame, NUBASE::Data("", table.year));
+  };
+
+  // Only in the older table
+  add_isotope(before, 10, 4, Number{ 12607.5, 0.1 });
+  // Unchanged
+  add_isotope(before, 12, 6, Number{ 0.0, 0.0 });
+  add_isotope(after, 12, 6, Number{ 0.0, 0.0 });
+  // Changed, tables are deliberately in a different order
+  add_isotope(after, 14, 6, Number{ 3022.0, 4.0 });
+  add_isotope(before, 14, 6, Number{ 3019.0, 3.0 });
+  // Missing value in one of the tables
+  add_isotope(before, 16, 8, Number{ std::numeric_limits<double>::max(), 1.0 });
+  add_isotope(after, 16, 8, Number{ -4737.0, 1.0 });
+  // Only in the newer table
+  add_isotope(after, 300, 118, Number{ 1.0, 1.0 });
+
+  TableDiff diff({ Quantity::AME_MASS_EXCESS });
+
+  REQUIRE(diff.compare(before, after));
+  REQUIRE(diff.year_before == 2016);
+  REQUIRE(diff.year_after == 2020);
+
+  SECTION("Added and removed isotopes are found")
+  {
+    REQUIRE(diff.removed.size() == 1);
+    REQUIRE(diff.removed.front().A == 10);
+    REQUIRE(diff.removed.front().Z == 4);
+
+    REQUIRE(diff.added.size() == 1);
+    REQUIRE(diff.added.front().A == 300);
+    REQUIRE(diff.added.front().Z == 118);
+  }
+
+  SECTION("Only the changed value is recorded")
+  {
+    REQUIRE(diff.changed.size() == 1);
+
+    const auto& change = diff.changed.front();
+    REQUIRE(change.A == 14);
+    REQUIRE(change.Z == 6);
+    REQUIRE(change.quantity == Quantity::AME_MASS_EXCESS);
+    REQUIRE(change.before == Catch::Approx(3019.0));
+    REQUIRE(change.after == Catch::Approx(3022.0));
+    REQUIRE(change.delta == Catch::Approx(3.0));
+    REQUIRE(change.significance == Catch::Approx(0.6));
+  }
+
+  SECTION("Small changes can be ignored")
+  {
+    diff.threshold = 5.0;
+    REQUIRE(diff.compare(before, after));
+    REQUIRE(diff.changed.empty());
+  }
+}
+
+
+TEST_CASE("Compare the same year", "[TableDiff]")
+{
+  MassTable table(2020);
+  REQUIRE(table.populateInternalMassTable());
+
+  TableDiff diff;
+  REQUIRE(diff.compare(table, table));
+
+  REQUIRE(diff.added.empty());
+  REQUIRE(diff.removed.empty());
+  REQUIRE(diff.changed.empty());
+}
+
+
+TEST_CASE("Compare different years", "[TableDiff]")
+{
+  MassTable before(2016);
+  REQUIRE(before.populateInternalMassTable());
+  MassTable after(2020);
+  REQUIRE(after.populateInternalMassTable());
+
+  TableDiff diff({ Quantity::S_2N });
+  REQUIRE(diff.compare(before, after));
+
+  REQUIRE_FALSE(diff.added.empty());
+  REQUIRE_FALSE(diff.changed.empty());
+  REQUIRE(before.fullDataTable.size() - diff.removed.size() + diff.added.size() == after.fullDataTable.size());
+  REQUIRE(std::all_of(diff.changed.cbegin(), diff.changed.cend(), [](const auto& change) {
+    return change.quantity == Quantity::S_2N && std::isfinite(change.delta);
+  }));
+}
@@ -0,0 +1,135 @@
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+#include "nuclear-data-reader/table_handle.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+  MassTable quietTable(const uint16_t year)
+  {
+    MassTable table(year);
+    table.diagnostics.silence();
+    return table;
+  }
+} // namespace
+
+
+TEST_CASE("Nothing is pinned before the first load", "[TableHandle]")
+{
+  const TableHandle handle(quietTable(2020));
+
+  const auto pin = handle.pin();
+  REQUIRE_FALSE(pin);
+  REQUIRE(pin.number() == 0);
+  REQUIRE(handle.version() == 0);
+}
+
+
+TEST_CASE("Reload the table", "[TableHandle]")
+{
+  TableHandle handle(quietTable(2020));
+  REQUIRE(handle.reload());
+  REQUIRE(handle.version() == 1);
+
+  SECTION("Pins read the current version")
+  {
+    const auto pin = handle.pin();
+    REQUIRE(pin);
+    REQUIRE(pin.number() == 1);
+    REQUIRE(pin->getQuantity(19, 8, Quantity::AME_MASS_EXCESS).value().amount == Catch::Approx(3332.858));
+  }
+
+  SECTION("A pinned version outlives the reload that replaces it")
+  {
+    auto old = handle.pin();
+
+    // The reload can only finish once the old version is unpinned, so run it on another thread
+    REQUIRE(handle.reloadInBackground());
+    while (handle.version() != 2)
+      {
+        std::this_thread::yield();
+      }
+
+    REQUIRE(old.number() == 1);
+    REQUIRE(old->getQuantity(19, 8, Quantity::S_N).has_value());
+    REQUIRE(handle.pin().number() == 2);
+    REQUIRE(handle.reloading());
+
+    old.release();
+    while (handle.reloading())
+      {
+        std::this_thread::yield();
+      }
+    REQUIRE_FALSE(old);
+  }
+
+  SECTION("Moving a pin keeps it")
+  {
+    auto first        = handle.pin();
+    const auto second = std::move(first);
+    REQUIRE_FALSE(first);
+    REQUIRE(second.number() == handle.version());
+  }
+}
+
+
+TEST_CASE("A failed reload is not published", "[TableHandle]")
+{
+  // Bypass the validation of the year so the data files can not be found
+  auto table = quietTable(2020);
+  table.year = 1900;
+
+  TableHandle handle(std::move(table));
+  REQUIRE_FALSE(handle.reload());
+  REQUIRE(handle.version() == 0);
+  REQUIRE_FALSE(handle.pin());
+}
+
+
+TEST_CASE("Read while the table is reloaded", "[TableHandle]")
+{
+  TableHandle handle(quietTable(2020));
+  REQUIRE(handle.reload());
+
+  constexpr std::size_t n_threads{ 4 };
+  std::atomic<bool> done{ false };
+  std::vector<std::size_t> missing(n_threads, 0);
+  {
+    std::vector<std::jthread> readers;
+    for (std::size_t i = 0; i < n_threads; ++i)
+      {
+        readers.emplace_back([&handle, &done, &missing, i]() {
+          while (!done.load())
+            {
+              const auto pin = handle.pin();
+              if (!pin || !pin->getQuantity(19, 8, Quantity::AME_MASS_EXCESS).has_value())
+                {
+                  ++missing[i];
+                }
+            }
+        });
+      }
+
+    for (auto reload = 0; reload < 3; ++reload)
+      {
+        REQUIRE(handle.reload());
+      }
+    done.store(true);
+  }
+
+  REQUIRE(handle.version() == 4);
+  for (const auto count : missing)
+    {
+      REQUIRE(count == 0);
+    }
+}
@@ -0,0 +1,127 @@
+#include "nuclear-data-reader/massTable.hpp"
+#include "nuclear-data-reader/nubase_decay_mode.hpp"
+#include "nuclear-data-reader/quantity.hpp"
+#include "nuclear-data-reader/table_snapshot.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("Take a snapshot of a populated table", "[TableSnapshot]")
+{
+  MassTable table(2020);
+  table.diagnostics.silence();
+  REQUIRE(table.populateInternalMassTable());
+
+  const TableSnapshot snapshot(table);
+
+  SECTION("Every isotope is copied")
+  {
+    REQUIRE(snapshot.getYear() == 2020);
+    REQUIRE(snapshot.size() == table.fullDataTable.size());
+
+    const auto row = snapshot.find(19, 8);
+    REQUIRE(row.has_value());
+    REQUIRE(snapshot.nuclide(row.value()).N == 11);
+    REQUIRE(snapshot.getQuantity(19, 8, Quantity::AME_MASS_EXCESS).value().amount == Catch::Approx(3332.858));
+    REQUIRE(snapshot.getQuantity(19, 8, Quantity::S_N).value().amount == Catch::Approx(3955.6439));
+  }
+
+  SECTION("Values match the table")
+  {
+    for (std::size_t row = 0; row < snapshot.size(); row += 97)
+      {
+        const auto& isotope = table.fullDataTable[row];
+        REQUIRE(snapshot.find(isotope.ame.A, isotope.ame.Z) == row);
+        REQUIRE(snapshot.getQuantity(row, Quantity::Q_ALPHA).amount
+                == Catch::Approx(isotope.getQuantity(Quantity::Q_ALPHA).amount));
+        REQUIRE(snapshot.getQuantity(row, Quantity::HALF_LIFE).amount
+                == Catch::Approx(isotope.getQuantity(Quantity::HALF_LIFE).amount));
+      }
+  }
+
+  SECTION("Decay branches and isomers")
+  {
+    // 212Po: A=100
+    const auto branches = snapshot.getDecayBranches(212, 84);
+    REQUIRE(branches.size() == 1);
+    REQUIRE(branches.front().mode == NUBASE::DecayMode::common("A"));
+
+    const auto states = snapshot.getIsomers(178, 72);
+    REQUIRE(states.size() == 3);
+    REQUIRE(states[1].energy == Catch::Approx(2446.09));
+  }
+
+  SECTION("Locate by position on the chart")
+  {
+    const auto oxygen = snapshot.isotopicChain(8);
+    REQUIRE_FALSE(oxygen.empty());
+    for (const auto row : oxygen)
+      {
+        REQUIRE(snapshot.nuclide(row).Z == 8);
+      }
+
+    REQUIRE(snapshot.getRegion(8, 8, 0, 200).size() == oxygen.size());
+  }
+
+  SECTION("Unknown isotopes")
+  {
+    REQUIRE_FALSE(snapshot.find(300, 200).has_value());
+    REQUIRE_FALSE(snapshot.find(1, 2).has_value());
+    REQUIRE_FALSE(snapshot.getQuantity(1, 100, Quantity::S_N).has_value());
+    REQUIRE(snapshot.getDecayBranches(300, 200).empty());
+    REQUIRE(snapshot.getIsomers(300, 200).empty());
+  }
+}
+
+
+TEST_CASE("Deferred reactions are read before the snapshot is taken", "[TableSnapshot]")
+{
+  MassTable lazy(2020);
+  lazy.diagnostics.silence();
+  lazy.load_mode = MassTable::LoadMode::LAZY_REACTIONS;
+  REQUIRE(lazy.populateInternalMassTable());
+
+  const TableSnapshot snapshot(lazy);
+  REQUIRE_FALSE(lazy.reaction_load.pending);
+  REQUIRE(snapshot.getQuantity(19, 8, Quantity::S_N).value().amount == Catch::Approx(3955.6439));
+}
+
+
+TEST_CASE("Read a snapshot from many threads", "[TableSnapshot]")
+{
+  MassTable table(2020);
+  table.diagnostics.silence();
+  REQUIRE(table.populateInternalMassTable());
+
+  const TableSnapshot snapshot(table);
+
+  constexpr std::size_t n_threads{ 4 };
+  std::vector<std::size_t> found(n_threads, 0);
+  {
+    std::vector<std::jthread> readers;
+    for (std::size_t i = 0; i < n_threads; ++i)
+      {
+        readers.emplace_back([&snapshot, &found, i]() {
+          for (std::size_t row = 0; row < snapshot.size(); ++row)
+            {
+              const auto nuclide = snapshot.nuclide(row);
+              if (snapshot.getQuantity(nuclide.A, nuclide.Z, Quantity::AME_MASS_EXCESS).has_value())
+                {
+                  ++found[i];
+                }
+            }
+        });
+      }
+  }
+
+  for (const auto count : found)
+    {
+      REQUIRE(count == snapshot.size());
+    }
+}